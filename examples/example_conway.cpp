@@ -12,11 +12,10 @@ Sequence<Color> g_colorSpectrum;
 class Cell : public GameObject {
 public:
 
-    Cell(float size) {
-        sr = addComponent<ShapeRenderer>();
-        sr->setColor(Whites::White);
-        sr->setShape(make<SquareShape>(size));
-        sr->setEnabled(false);
+    Cell(Handle<InstancedShapeRenderer> _sr, std::size_t _index) :
+        sr(_sr), index(_index)
+    {
+        sr->setInstanceEnabled(index, false);
     }
 
     void update() override {
@@ -39,13 +38,10 @@ public:
             alive = false;
             age = 0;
         }
-        if (alive)
-            sr->setEnabled(true);
-        else
-            sr->setEnabled(false);
+        sr->setInstanceEnabled(index, alive);
         float t = Math::clamp01((float)age / (500.0f));
         auto color = g_colorSpectrum(t);
-        sr->setColor(color);
+        sr->setInstanceColor(index, color);
     }
 
     std::size_t livingNeighbors() {
@@ -65,7 +61,8 @@ public:
     bool alive    = false;
     bool willLive = false;
     Handle<Cell> left, right, top, bottom;
-    Handle<ShapeRenderer> sr;
+    Handle<InstancedShapeRenderer> sr;
+    std::size_t index;
 };
 
 class Conway : public GameObject {
@@ -76,6 +73,7 @@ public:
         C((std::size_t)(width/size))
     {
         cells.resize(R);
+        cellRenderer = addComponent<InstancedShapeRenderer>(make<SquareShape>(size));
         loadBg = addComponent<ShapeRenderer>(make<RectangleShape>(505,25));
         loadBg->setColor(Grays::Gray50);
         loadBg->getShape()->move(960,540);
@@ -90,9 +88,9 @@ public:
         for (auto r : range(R)) {
             cells[r].resize(C);
             for (auto c : range(C)) {
-                auto cell = makeChild<Cell>(size);
+                auto index = cellRenderer->addInstance(Vector2f(size/2 + c * size, size/2 + r * size));
+                auto cell = makeChild<Cell>(cellRenderer, index);
                 cell->setEnabled(false);
-                cell->transform.setPosition(size/2 + c * size, size/2 + r * size);
 
                 // setup doubly link list
                 if (r != 0) {
@@ -171,6 +169,7 @@ public:
 public:
     bool loaded = false;
     Handle<ShapeRenderer> loadBg, loadFg;
+    Handle<InstancedShapeRenderer> cellRenderer;
     Ptr<RectangleShape> loadRect;
     float width, height, size;
     std::size_t R, C;
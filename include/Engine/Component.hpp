@@ -5,6 +5,7 @@
 namespace carnot {
 
 class GameObject;
+namespace detail { class ComponentRegistry; }
 
 class Component : public Object {
 public:
@@ -57,9 +58,12 @@ private:
 
     friend class Engine;
     friend class GameObject;
+    friend class detail::ComponentRegistry;
 
     /// Calls update and resumes coroutines
     void updateAll();
+    /// Queues the GameObject's tick list entries to be updated
+    void refreshTicks(bool subtree) override;
 
 public:
 
@@ -69,6 +73,7 @@ private:
 
     bool m_startCalled;                       ///< true if start() has been called
     std::size_t m_index;                      ///< Component sibling index within Object
+    std::size_t m_registryIndex;              ///< index within the ComponentRegistry, or ComponentRegistry::npos
 
 };
 
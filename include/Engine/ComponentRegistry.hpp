@@ -0,0 +1,118 @@
+#pragma once
+
+#include <Engine/Component.hpp>
+#include <algorithm>
+#include <type_traits>
+
+namespace carnot {
+namespace detail {
+
+/// Engine-wide registry of attached Components, kept in dense arrays per
+/// concrete Component type. Components are added when attached to a
+/// GameObject and removed when removed or destroyed. Used to implement
+/// Engine::each and Engine::parallelEach [internal use only].
+class ComponentRegistry {
+public:
+
+    /// Registry index of a Component which isn't registered
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// Registers an attached Component
+    static void add(Component* component);
+    /// Unregisters a Component (no-op if not registered)
+    static void remove(Component* component);
+
+    /// Calls fn for every registered Component of type T (including derived types)
+    template <typename T, typename F>
+    static void each(F&& fn);
+    /// Gathers every registered Component of type T into a contiguous list
+    template <typename T>
+    static std::vector<T*> gather();
+
+    /// Returns the number of registered Components of type T (including derived types)
+    template <typename T>
+    static std::size_t count();
+    /// Returns the total number of registered Components
+    static std::size_t count();
+
+private:
+
+    /// Marks the start of an iteration (removals are deferred until the end)
+    static void beginIteration();
+    /// Marks the end of an iteration and compacts deferred removals
+    static void endIteration();
+    /// Returns true if removed Components are awaiting compaction
+    static bool hasTombstones();
+    /// Dense arrays of Components indexed by concrete TypeId
+    static std::vector<std::vector<Component*>>& arrays();
+    /// Returns true if the Components in an array are T's
+    template <typename T>
+    static bool matches(const std::vector<Component*>& array);
+};
+
+//==============================================================================
+// Template / Inline Function Implementations
+//==============================================================================
+
+template <typename T>
+bool ComponentRegistry::matches(const std::vector<Component*>& array) {
+    for (auto component : array) {
+        if (component != nullptr)
+            return isA<T>(component);
+    }
+    return false;
+}
+
+template <typename T, typename F>
+void ComponentRegistry::each(F&& fn) {
+    static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
+    auto& all = arrays();
+    beginIteration();
+    // index freshly on every access since fn may add Components
+    for (std::size_t t = 0; t < all.size(); ++t) {
+        if (!matches<T>(all[t]))
+            continue;
+        for (std::size_t i = 0, n = all[t].size(); i < n; ++i) {
+            Component* component = all[t][i];
+            if (component != nullptr)
+                fn(*static_cast<T*>(component));
+        }
+    }
+    endIteration();
+}
+
+template <typename T>
+std::vector<T*> ComponentRegistry::gather() {
+    static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
+    std::vector<T*> components;
+    auto& all = arrays();
+    for (std::size_t t = 0; t < all.size(); ++t) {
+        if (!matches<T>(all[t]))
+            continue;
+        components.reserve(components.size() + all[t].size());
+        for (auto component : all[t]) {
+            if (component != nullptr)
+                components.push_back(static_cast<T*>(component));
+        }
+    }
+    return components;
+}
+
+template <typename T>
+std::size_t ComponentRegistry::count() {
+    static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
+    std::size_t n = 0;
+    auto& all = arrays();
+    for (std::size_t t = 0; t < all.size(); ++t) {
+        if (!matches<T>(all[t]))
+            continue;
+        n += all[t].size();
+        // removals during each() leave nullptrs until it ends
+        if (hasTombstones())
+            n -= std::count(all[t].begin(), all[t].end(), nullptr);
+    }
+    return n;
+}
+
+} // namespace detail
+} // namespace carnot
@@ -1,14 +1,23 @@
 #pragma once
 
 #include <Engine/Component.hpp>
+#include <Utility/Affine.hpp>
 
 namespace carnot {
 
+namespace Transforms { namespace detail { class Store; } }
+
+/// A Component describing the position, rotation and scale of a GameObject.
+/// The TRS values and matrices live in the engine owned Transform store,
+/// which recomputes all dirty world matrices once per frame; queries made
+/// between passes are brought up to date lazily.
 class Transform : public Component {
 public:
 
     /// Constructor
     Transform(GameObject& gameObject);
+    /// Destructor
+    ~Transform();
 
     //==========================================================================
     // World Absolute Transformation Functions
@@ -24,6 +33,8 @@ public:
     void setRotation(float angle);
     /// Gets the global rotation of the Object
     float getRotation() const;
+    /// Sets the global position and rotation of the Object in a single update
+    void setPositionAndRotation(const Vector2f& position, float angle);
     /// Sets the global scale of the Object
     void setScale(float factorX, float factorY);
     /// Sets the global scale of the Object
@@ -34,6 +45,12 @@ public:
     Matrix3x3 getWorldMatrix() const;
     /// Gets the inverse global Transform of the Object
     Matrix3x3 getInverseWorldMatrix() const;
+    /// Gets the global Transform of the Object as a compact 2D affine
+    Affine getWorldAffine() const;
+    /// Gets the inverse global Transform of the Object as a compact 2D affine
+    Affine getInverseWorldAffine() const;
+    /// Gets a counter that changes whenever the global Transform changes
+    std::size_t getVersion() const;
 
     //==========================================================================
     // Local Absolute Transformation Functions
@@ -54,17 +71,19 @@ public:
     /// Sets the local origin of the Object
     void setLocalOrigin(const Vector2f& origin);
     /// Gets the local position of the Object
-    const Vector2f& getLocalPosition() const;
+    Vector2f getLocalPosition() const;
     /// Gets the local rotation of the Object
     float getLocalRotation() const;
     /// Gets the local scale of the Object
-    const Vector2f& getLocalScale() const;
+    Vector2f getLocalScale() const;
     /// Gets the local origin of the Object
-    const Vector2f& getLocalOrigin() const;
+    Vector2f getLocalOrigin() const;
     /// Gets the local Transform of the Object in Local coordinates
-    const Matrix3x3& getLocalMatrix() const;
+    Matrix3x3 getLocalMatrix() const;
     /// Gets the inverse local Transform of the Object in Local coordinates
-    const Matrix3x3& getInverseLocalMatrix() const;
+    Matrix3x3 getInverseLocalMatrix() const;
+    /// Gets the local Transform of the Object as a compact 2D affine
+    Affine getLocalAffine() const;
 
     //==========================================================================
     // Local Relative Transformation Functions
@@ -96,32 +115,37 @@ public:
 
 public:
 
-    ProtectedSignal<void(void), Transform> onChanged;  ///< emitted when Transform changes
+    ProtectedSignal<void(void), Transform> onChanged;  ///< emitted once per frame when the global Transform changed
 
 private:
 
-    /// Makes the transform and its children dirty
+    friend class GameObject;
+    friend class Engine;
+    friend class Transforms::detail::Store;
+
+    /// Makes the local transform dirty; children are invalidated lazily
     void makeDirty();
+    /// Makes the global transform dirty (e.g. after reparenting)
+    void makeWorldDirty();
+    /// Updates the parent slot in the store after the GameObject was reparented
+    void updateParent();
+    /// Emits onChanged for all Transforms that changed since the last call
+    static void processChanges();
+    /// Emits onChanged for this Transform and its children if their global Transform changed
+    void notifyChanged(std::size_t pass);
 
     /// Renders the Transform axis handles during Debug mode
     void onGizmo() override;
 
 private:
 
-    Vector2f          m_origin;                 ///< Local Origin of translation/rotation/scaling of the object
-    Vector2f          m_position;               ///< Local Position of the object in the 2D world
-    float             m_rotation;               ///< Local Orientation of the Object, in degrees
-    Vector2f          m_scale;                  ///< Local Scale of the object
-
-    mutable Matrix3x3 m_localTransform;         ///< Combined transformation of the object
-    mutable Matrix3x3 m_worldTransform;         ///< Global tansform of the Object
-    mutable Matrix3x3 m_invLocalTransform;      ///< Inverse combined transformation of the object
-    mutable Matrix3x3 m_invWorldTransform;      ///< Inverse global transform of the Object
+    /// Value of m_changeIndex when the Transform isn't in the pending change list
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
-    mutable bool      m_localTransformDirty;    ///< Does the transform need to be recomputed?
-    mutable bool      m_worldTransformDirty;    ///< Does the transform need to be recomputed?
-    mutable bool      m_invLocalTransformDirty; ///< Does the transform need to be recomputed?
-    mutable bool      m_invWorldTransformDirty; ///< Does the transform need to be recomputed?
+    std::size_t m_slot;             ///< Index into the Transform store
+    std::size_t m_notifiedVersion;  ///< Generation onChanged was last emitted for
+    std::size_t m_notifiedPass;     ///< Last processChanges pass that visited this Transform
+    std::size_t m_changeIndex;      ///< Index into the pending change list (or npos)
 
 };
 
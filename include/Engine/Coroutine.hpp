@@ -21,7 +21,7 @@ using SuspendNever  = std::experimental::suspend_never;
 //==============================================================================
 
 /// Coroutine yield instruction base class
-struct YieldInstruction {
+struct YieldInstruction : public Tracked {
     YieldInstruction();
     virtual ~YieldInstruction();
     virtual bool isOver();
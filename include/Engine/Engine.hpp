@@ -5,7 +5,11 @@
 #include <Engine/ResourceManager.hpp>
 #include <Engine/DebugSystem.hpp>
 #include <Engine/InputSystem.hpp>
+#include <Engine/TransformSystem.hpp>
+#include <Engine/ComponentRegistry.hpp>
+#include <Engine/JobSystem.hpp>
 #include <Physics/PhysicsSystem.hpp>
+#include <algorithm>
 
 namespace carnot {
 class Engine { 
@@ -28,10 +32,17 @@ static void run();
 static void stop();
 /// Returns the current Engine time
 static float time();
-/// Returns the elapsed time since the last frame update
+/// Returns the elapsed time since the last frame update (or, inside the
+/// update of a throttled Object, the time since that Object's last update)
 static float deltaTime();
 /// Returns the current frame number
 static std::size_t frame();
+/// Sets the per-frame time budget in milliseconds for Low priority updates (0 = unlimited)
+static void setUpdateBudget(float milliseconds);
+/// Gets the per-frame time budget in milliseconds for Low priority updates
+static float getUpdateBudget();
+/// Returns the Engine's work-stealing JobSystem (started on first use)
+static JobSystem& jobs();
 
 //=============================================================================
 // RENDERING
@@ -65,6 +76,21 @@ static void setRoot(Ptr<GameObject> root);
 /// Gets a Handle to the root Object of the Engine
 static Handle<GameObject> getRoot();
 
+//=============================================================================
+// COMPONENT QUERIES
+//=============================================================================
+
+/// Calls fn(T&) for every attached Component of type T (including derived
+/// types) in the Engine. Components removed during iteration are skipped and
+/// Components added during iteration are not visited.
+template <typename T, typename F> static void each(F&& fn);
+/// Calls fn(T&) for every attached Component of type T split across worker
+/// threads. fn must not touch non thread-safe Engine state; GameObject
+/// changes it makes are deferred and applied in Component order afterwards.
+template <typename T, typename F> static void parallelEach(F&& fn);
+/// Returns the number of attached Components of type T in the Engine
+template <typename T> static std::size_t count();
+
 //=============================================================================
 // GLOBAL RESOURCES
 //=============================================================================
@@ -84,6 +110,10 @@ static ResourceManager<Shader>      shaders;  ///< shaders
 
 private:
 
+    friend class GameObject;
+
+    /// Overrides deltaTime() during a throttled Object's update (negative to clear)
+    static void setTickDelta(float delta);
     static void eventThread();
     static void renderThread();
     static void render();
@@ -97,9 +127,39 @@ private:
 
 template <typename T, typename ...Args>
 Handle<T> Engine::makeRoot(Args... args) {
-    auto root = make<T>(args...);
+    auto root = makeObject<T>(args...);
     setRoot(root);
     return getRoot().as<T>();
 }
 
+template <typename T, typename F>
+void Engine::each(F&& fn) {
+    detail::ComponentRegistry::each<T>(std::forward<F>(fn));
+}
+
+template <typename T, typename F>
+void Engine::parallelEach(F&& fn) {
+    auto components = detail::ComponentRegistry::gather<T>();
+    // run as a parallel section, deferring side effects per chunk
+    std::size_t grain = std::max<std::size_t>(1, components.size() / (jobs().getThreadCount() * 4));
+    std::vector<detail::DeferQueue> deferred((components.size() + grain - 1) / grain);
+    jobs().parallelFor(components.size(), [&](std::size_t begin, std::size_t end) {
+        auto& queue = detail::deferQueue();
+        auto previous = queue;
+        queue = &deferred[begin / grain];
+        for (std::size_t i = begin; i < end; ++i)
+            fn(*components[i]);
+        queue = previous;
+    }, grain);
+    for (auto& queue : deferred) {
+        for (auto& call : queue)
+            call();
+    }
+}
+
+template <typename T>
+std::size_t Engine::count() {
+    return detail::ComponentRegistry::count<T>();
+}
+
 } // namespace carnot
\ No newline at end of file
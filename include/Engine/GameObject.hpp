@@ -16,6 +16,8 @@ public:
     GameObject();
     /// Constructs an GameObject with a defined name
     GameObject(const Name& name);
+    /// Destructor
+    ~GameObject();
 
     //==========================================================================
     // General Functions
@@ -29,6 +31,19 @@ public:
     bool isActive() const;
     /// Makes a Handle for this GameObject
     Handle<GameObject> getHandle() const;
+    /// Declares the update() of this GameObject's child subtrees safe to run
+    /// concurrently. Each child may only modify its own subtree. Structural
+    /// changes, Signal emissions and defer() calls made meanwhile are replayed
+    /// serially in child order once all children have updated, and start()
+    /// runs serially beforehand. Objects can't be created from a parallel
+    /// update() except through defer(). Transforms outside the subtree which
+    /// serial updates moved after the first parallel GameObject of the frame
+    /// updated shouldn't be read from a parallel update().
+    void setParallelChildren(bool parallel);
+    /// Returns true if this GameObject's children update in parallel
+    bool hasParallelChildren() const;
+    /// Runs fn now, or at the merge point if called from a parallel update
+    static void defer(std::function<void()> fn);
 
     //==========================================================================
     // Child Functions
@@ -114,51 +129,108 @@ protected:
 
     friend class Engine;
     friend class Transform;
+    friend class Component;
+    template <typename T> friend class ObjectPool;
 
 private:
 
+    /// Index returned by the find functions when nothing matches
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
     /// Attaches a Component to this GameObject
     Handle<Component> attachComponent(Ptr<Component> component);
+    /// Returns the index of the first child matching a type query (or npos)
+    std::size_t findChildIndex(TypeId query, bool(*isA)(const Object*)) const;
+    /// Returns the number of children matching a type query
+    std::size_t countChildren(TypeId query, bool(*isA)(const Object*)) const;
+    /// Returns the index of the first Component matching a type query (or npos)
+    std::size_t findComponentIndex(TypeId query, bool(*isA)(const Object*)) const;
     /// Updates the m_index member variable of all children
     void updateChildIndices();
     /// Updates the m_index member variable of all components
     void updateComponentIndices();
-    /// Updates child GameObjects
-    void updateChildren();
-    /// Updates Components
-    void updateComponents();
-    /// Process added GameObjects/Components
-    void processAdditions();
-    /// Processs deleted GameObjects/Components
-    void processDeletions();
-
-    /// Updates the GameObject and then recursively updates all of its children
+    /// Deferred structural change (see processCommands)
+    struct Command;
+    /// Queue of structural changes made while children/Components were being iterated
+    static std::vector<Command>& commands();
+    /// Applies a group of queued changes targeting this GameObject with a single index fix-up
+    void applyCommands(Command* begin, Command* end);
+    /// Applies all queued structural changes in one batch, grouped by target [called by Engine]
+    static void processCommands();
+    /// Calls onSpawn for all Components, this GameObject, and then all children
+    void spawnAll();
+    /// Stops coroutines and calls onDespawn for all Components, this GameObject, and then all children
+    void despawnAll();
+
+    /// Returns true if this GameObject is in the tick lists while they are being iterated
+    bool isTicking() const;
+    /// Lists the tree rooted at this GameObject if it is a new root and applies queued tick refreshes
+    void buildTicks();
+    /// Entries collected for insertion into the tick lists
+    struct TickBatch;
+    /// Appends this GameObject's entries, and its subtree's if subtree is true, to a batch
+    void collectTicks(TickBatch& batch, bool subtree);
+    /// Inserts this GameObject's entries, or its subtree's if it should be listed, into the tick lists
+    void listTicks(bool subtree);
+    /// Removes this GameObject's entries, or its subtree's, from the tick lists
+    void unlistTicks(bool subtree);
+    /// Removes and reinserts this GameObject's entries, or its subtree's
+    void updateTicks(bool subtree);
+    /// Queues this GameObject's entries, or its subtree's, to be updated before the lists are next iterated
+    void refreshTicks(bool subtree) override;
+    /// Removes, in one pass, the update entries left only for start() calls which have run
+    static void pruneTicks();
+    /// Brings the world matrices of this GameObject's subtree and ancestors up to date
+    void validateTransforms() const;
+    /// Gets the depth of this GameObject in the tree the tick lists were built from
+    std::size_t getTickDepth() const;
+    /// Compares the position of owner's entries with the subtree of target at depth (<0 before, 0 within, >0 after)
+    static int compareTicks(const GameObject* owner, const GameObject* target, std::size_t depth);
+
+    /// Starts/updates all GameObjects and Components in the tree which need it
     void updateAll();
-    /// Updates the GameObject and then recursively updates all of its children
+    /// Late updates all GameObjects and Components in the tree which override lateUpdate
     void lateUpdateAll();
-    /// Ques the GameObject for rendering and the recursively ques all of its children
+    /// Numbers the enabled Renderers in draw order, then ques all Components
+    /// in the tree which override onRender for rendering
     void onRender(RenderQue& que) final;
-    /// Calls onGizmo for all cildren and components
+    /// Calls onGizmo for all Components in the tree which override it
     void onGizmo() final;
-    /// Updates all Physics children and compoents
+    /// Calls onPhysics for all Components in the tree which override it
     void onPhysics() final;
 
 private:
 
     std::vector<Ptr<GameObject>> m_children;    ///< list of current child GameObjects
-    std::vector<Ptr<GameObject>> m_childrenAdd; ///< list of child GameObjects to be added
-    std::vector<GameObject*>     m_childrenDel; ///< list of child GameObjects to be destroyed
     mutable bool m_iteratingChildren;       ///< true if children currently being iterated
     mutable bool m_startCalled;             ///< Has start() been called?
 
     std::vector<Ptr<Component>> m_components;
-    std::vector<Ptr<Component>> m_componentsAdd;
-    std::vector<Component*>     m_componentsDel;
     mutable bool m_iteratingComponents;
 
     GameObject* m_parent;                 ///< pointer to parent GameObject
     std::size_t m_index;                  ///< sibling index within parent GameObject
     bool m_isRoot;
+    bool m_despawned;                     ///< true if currently held by an ObjectPool
+    bool m_parallelChildren;              ///< true if children update in parallel
+
+    bool m_listed;                        ///< true if this GameObject's subtree is in the tick lists
+    unsigned char m_tickRefresh;          ///< tick list update queued by refreshTicks
+    GameObject* m_tickParent;             ///< parent when listed (m_parent may change before the lists are updated)
+    std::size_t m_tickIndex;              ///< sibling index when listed, which orders the entries of siblings
+    GameObject* m_tickGroup;              ///< parallel GameObject whose group holds the update ticks of the children (or nullptr)
+
+    /// Cached result of a typed child query
+    struct ChildLookup {
+        std::size_t first = npos;         ///< index of first match (npos if none)
+        std::size_t count = npos;         ///< number of matches (npos if not yet counted)
+    };
+
+    /// Returns the cached result of a typed child query, computing it if needed
+    ChildLookup lookupChildren(TypeId query, bool(*isA)(const Object*)) const;
+
+    mutable std::vector<std::size_t> m_componentLookup; ///< first Component index + 1 per query TypeId (0 = unknown)
+    mutable std::vector<ChildLookup> m_childLookup;     ///< typed child queries per query TypeId
 
  public:
 
@@ -172,29 +244,21 @@ private:
 
 template <typename T>
 std::size_t GameObject::getChildCount() {
-    std::size_t count = 0;
-    for (std::size_t i = 0; i < m_children.size(); ++i) {
-        auto ptr = std::dynamic_pointer_cast<T>(m_children[i]);
-        if (ptr != nullptr)
-            count++;
-    }
-    return count;
+    return countChildren(typeId<T>(), &detail::isA<T>);
 }
 
 template <typename T, typename ...Args>
 Handle<T> GameObject::makeChild(Args... args) {
-    auto child = std::make_shared<T>(std::forward<Args>(args)...);
+    auto child = makeObject<T>(std::forward<Args>(args)...);
     attachChild(child);
     return Handle<T>(child);
 }
 
 template <typename T>
 Handle<T> GameObject::findChild() {
-    for (std::size_t i = 0; i < m_children.size(); ++i) {
-        auto ptr = std::dynamic_pointer_cast<T>(m_children[i]);
-        if (ptr != nullptr)
-            return Handle<T>(ptr);
-    }
+    std::size_t index = findChildIndex(typeId<T>(), &detail::isA<T>);
+    if (index != npos)
+        return Handle<T>(std::static_pointer_cast<T>(m_children[index]));
     return Handle<T>();
 }
 
@@ -207,29 +271,29 @@ Handle<T> GameObject::findSibling() {
 
 template <typename T, typename ...Args>
 Handle<T> GameObject::addComponent(Args... args) {
-    auto component = std::make_shared<T>(*this, std::forward<Args>(args)...);
-    auto handle = attachComponent(std::move(component));
-    return handle.template as<T>();
+    auto component = makeObject<T>(*this, std::forward<Args>(args)...);
+    Handle<T> handle(component);
+    attachComponent(std::move(component));
+    return handle;
 }
 
 template <typename T>
 Handle<T> GameObject::getComponent() {
-    for (auto& comp : m_components) {
-        auto cast = std::dynamic_pointer_cast<T>(comp);
-        if (cast)
-            return Handle<T>(cast);
-    }
+    std::size_t index = findComponentIndex(typeId<T>(), &detail::isA<T>);
+    if (index != npos)
+        return Handle<T>(std::static_pointer_cast<T>(m_components[index]));
     return Handle<T>();
 }
 
 template <typename T> 
 std::vector<Handle<T>> GameObject::getComponents() {
     std::vector<Handle<T>> comps;
-    comps.reserve(getComponentCount());
-    for (auto& comp : m_components) {
-        auto cast = std::dynamic_pointer_cast<T>(comp);
-        if (cast)
-            comps.push_back(Handle<T>(cast));
+    std::size_t first = findComponentIndex(typeId<T>(), &detail::isA<T>);
+    if (first == npos)
+        return comps;
+    for (std::size_t i = first; i < m_components.size(); ++i) {
+        if (detail::isA<T>(m_components[i].get()))
+            comps.push_back(Handle<T>(std::static_pointer_cast<T>(m_components[i])));
     }
     return comps;
 };
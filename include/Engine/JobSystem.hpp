@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Utility/Types.hpp>
+#include <Utility/Handle.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace carnot {
+
+namespace detail {
+struct Job;
+} // namespace detail
+
+/// Handle to a job scheduled on a JobSystem
+class JobHandle {
+public:
+
+    /// Constructs an invalid JobHandle
+    JobHandle();
+    /// Returns true if the JobHandle refers to a job
+    bool isValid() const;
+    /// Returns true if the job has finished running
+    bool isDone() const;
+
+private:
+
+    friend class JobSystem;
+
+    Ptr<detail::Job> m_job; ///< the job
+};
+
+/// Work-stealing thread pool. Each worker owns a deque it pushes to and pops
+/// from at the back while idle workers steal from the front of others. Jobs
+/// may depend on other jobs, forming task graphs, and threads that wait on a
+/// job run other jobs until it completes, so waits may be nested freely.
+class JobSystem : private NonCopyable {
+public:
+
+    //==========================================================================
+    // Constructor/Destructor
+    //==========================================================================
+
+    /// Starts worker threads (0 = one less than the number of hardware threads, at least 1)
+    JobSystem(std::size_t workers = 0);
+    /// Finishes queued jobs and joins worker threads
+    ~JobSystem();
+
+    //==========================================================================
+    // Scheduling
+    //==========================================================================
+
+    /// Schedules a job to run on any thread
+    JobHandle schedule(std::function<void()> job);
+    /// Schedules a job to run once all of its dependencies have finished
+    JobHandle schedule(std::function<void()> job, const std::vector<JobHandle>& dependencies);
+    /// Blocks until a job has finished, running other jobs meanwhile
+    void wait(const JobHandle& job);
+    /// Blocks until all jobs have finished, running other jobs meanwhile
+    void wait(const std::vector<JobHandle>& jobs);
+    /// Calls fn(begin, end) over chunks of [0, count) in parallel and waits for
+    /// all chunks (grain = chunk size, 0 to pick one from the thread count)
+    void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& fn, std::size_t grain = 0);
+    /// Queues a function to run on the Engine's update thread at the start of the next frame
+    void runOnMainThread(std::function<void()> fn);
+
+    //==========================================================================
+    // Threads
+    //==========================================================================
+
+    /// Returns the number of threads which run jobs (workers + the waiting thread)
+    std::size_t getThreadCount() const;
+    /// Returns the index of the calling thread (1..N for workers, 0 for any other thread)
+    static std::size_t getThreadIndex();
+
+private:
+
+    friend class Engine;
+
+    /// A worker thread and its job deque
+    struct Worker {
+        std::mutex mutex;                    ///< guards jobs
+        std::deque<Ptr<detail::Job>> jobs;   ///< owner uses the back, thieves the front
+        std::thread thread;                  ///< the worker thread
+    };
+
+    /// Worker thread main loop
+    void workerLoop(std::size_t index);
+    /// Queues a job whose dependencies are met
+    void enqueue(Ptr<detail::Job> job);
+    /// Pops or steals one job and runs it, returns false if none was found
+    bool runOne();
+    /// Runs a job and releases its dependents
+    void execute(const Ptr<detail::Job>& job);
+    /// Runs all functions queued with runOnMainThread [called by Engine]
+    void runMainThreadJobs();
+
+    std::vector<std::unique_ptr<Worker>> m_workers;  ///< worker threads
+    std::atomic<bool> m_stop;                        ///< true when workers should exit
+    std::atomic<std::size_t> m_queued;               ///< number of jobs waiting in deques
+    std::atomic<std::size_t> m_next;                 ///< round-robin target for external pushes
+    std::mutex m_sleepMutex;                         ///< guards idle worker sleep
+    std::condition_variable m_wake;                  ///< wakes idle workers
+    std::mutex m_mainMutex;                          ///< guards m_mainJobs
+    std::vector<std::function<void()>> m_mainJobs;   ///< queued main thread functions
+};
+
+} // namespace carnot
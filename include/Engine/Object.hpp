@@ -2,6 +2,9 @@
 \
 #include <Engine/Coroutine.hpp>
 #include <Utility/Handle.hpp>
+#include <Utility/TypeId.hpp>
+#include <Utility/DeferQueue.hpp>
+#include <Utility/PoolAllocator.hpp>
 #include <Utility/Signal.hpp>
 #include <Engine/Id.hpp>
 #include <Utility/Types.hpp>
@@ -9,6 +12,7 @@
 #include <Utility/Random.hpp>
 #include <vector>
 #include <utility>
+#include <memory>
 
 
 namespace carnot {
@@ -20,6 +24,7 @@ namespace carnot {
 class Engine;
 class Object;
 class Renderer;
+namespace detail { struct TickTraits; }
 
 typedef std::vector<std::vector<const Renderer*>> RenderQue;
 
@@ -27,7 +32,7 @@ typedef std::vector<std::vector<const Renderer*>> RenderQue;
 // CLASS: Object
 //==============================================================================
 
-class Object : private NonCopyable {
+class Object : public Tracked, private NonCopyable {
 
 public:
 
@@ -56,6 +61,35 @@ public:
     void setEnabled(bool enabled);
     /// Returns true if the Object is enabled, false otherwise
     bool isEnabled() const;
+    /// Gets the TypeId of the Object's concrete type (InvalidTypeId if not made by the Engine)
+    TypeId getTypeId() const;
+
+    //==========================================================================
+    // Update Scheduling
+    //==========================================================================
+
+    /// Scheduling priority of update()
+    enum class UpdatePriority {
+        Normal, ///< updated in tree order every due frame
+        Low     ///< updated round-robin within the Engine's update budget (see Engine::setUpdateBudget)
+    };
+
+    /// Updates the Object only every Nth frame (1 = every frame). Objects
+    /// sharing an interval are staggered across frames by Id. Applies to
+    /// update() and coroutines; Engine::deltaTime() returns the time since
+    /// the Object's last update while it is being updated.
+    void setUpdateInterval(std::size_t frames);
+    /// Gets the update interval in frames
+    std::size_t getUpdateInterval() const;
+    /// Updates the Object at most hz times per second (0 = every frame),
+    /// staggered by Id. Overrides the update interval.
+    void setUpdateRate(float hz);
+    /// Gets the update rate in Hz (0 = every frame)
+    float getUpdateRate() const;
+    /// Sets the update priority
+    void setUpdatePriority(UpdatePriority priority);
+    /// Gets the update priority
+    UpdatePriority getUpdatePriority() const;
 
     //==========================================================================
     // Coroutine Functions
@@ -89,6 +123,10 @@ public:
 protected:
 
     friend class Engine;
+    friend class GameObject;
+    template <typename T, typename ...Args>
+    friend Ptr<T> makeObject(Args&& ...args);
+    friend struct detail::TickTraits;
 
     //==========================================================================
     // Virtual Callbacks
@@ -113,6 +151,10 @@ protected:
     virtual void onEnable();
     /// Called when the Obejct is disabled
     virtual void onDisable();
+    /// Called when the Object is spawned (or respawned) by an ObjectPool
+    virtual void onSpawn();
+    /// Called when the Object is returned to an ObjectPool
+    virtual void onDespawn();
 
     //==========================================================================
     // Protected Functions
@@ -127,10 +169,146 @@ private:
     // Member Data
     //==========================================================================
 
+    /// Callbacks an Object may receive from the Engine's tick lists. makeObject
+    /// sets only the bits of the callbacks the concrete type overrides, so
+    /// the lists skip Objects which would run the (empty) Object defaults.
+    enum Ticks : unsigned char {
+        TickUpdate     = 1 << 0,
+        TickLateUpdate = 1 << 1,
+        TickPhysics    = 1 << 2,
+        TickRender     = 1 << 3,
+        TickGizmo      = 1 << 4,
+        TickAll        = 0x1F
+    };
+
+    /// Queues the Engine's tick lists to pick up a change to the Object, or
+    /// to its whole subtree if subtree is true (does nothing by default)
+    virtual void refreshTicks(bool subtree);
+
+    /// Update throttling settings (only allocated when customized)
+    struct UpdateSchedule {
+        std::size_t interval = 1;                        ///< update every Nth frame
+        float period         = 0.0f;                     ///< seconds between updates (0 = use interval)
+        UpdatePriority priority = UpdatePriority::Normal;///< update priority
+        float lastTime       = -1.0f;                    ///< Engine time of last update (-1 = never)
+        float nextTime       = -1.0f;                    ///< Engine time of next rate-limited update (-1 = unset)
+    };
+
+    /// Returns the schedule, creating it if needed
+    UpdateSchedule& schedule();
+    /// Returns true if a throttled update is due this frame
+    bool isUpdateDue();
+
     Id m_id;                              ///< unique Id of the Object
+    TypeId m_typeId;                      ///< TypeId of the concrete type
     bool m_enabled;                       ///< whether or not the Object is enabled
+    unsigned char m_ticks;                ///< Ticks the Object overrides (all unless made by makeObject)
+    std::unique_ptr<UpdateSchedule> m_schedule; ///< update throttling, or nullptr to update every frame
     std::vector<Enumerator> m_coroutines; ///< Coroutines
 
 };
 
+//==============================================================================
+// Object Factory / Type Queries
+//==============================================================================
+
+namespace detail {
+
+/// Finds which Engine callbacks a type overrides at compile time, by checking
+/// whether naming them through the type still yields Object's members.
+/// Overrides which can't be named from here (e.g. private ones) count as
+/// overridden, which only costs a call to them.
+struct TickTraits {
+    template <typename T> static auto inheritsUpdate(int) -> std::is_same<decltype(&T::update), void (Object::*)()>;
+    template <typename T> static std::false_type inheritsUpdate(...);
+    template <typename T> static auto inheritsLateUpdate(int) -> std::is_same<decltype(&T::lateUpdate), void (Object::*)()>;
+    template <typename T> static std::false_type inheritsLateUpdate(...);
+    template <typename T> static auto inheritsPhysics(int) -> std::is_same<decltype(&T::onPhysics), void (Object::*)()>;
+    template <typename T> static std::false_type inheritsPhysics(...);
+    template <typename T> static auto inheritsRender(int) -> std::is_same<decltype(&T::onRender), void (Object::*)(RenderQue&)>;
+    template <typename T> static std::false_type inheritsRender(...);
+    template <typename T> static auto inheritsGizmo(int) -> std::is_same<decltype(&T::onGizmo), void (Object::*)()>;
+    template <typename T> static std::false_type inheritsGizmo(...);
+
+    /// Returns the Object::Ticks of the callbacks T overrides
+    template <typename T>
+    static constexpr unsigned char overridden() {
+        return (decltype(inheritsUpdate<T>(0))::value     ? 0 : Object::TickUpdate)     |
+               (decltype(inheritsLateUpdate<T>(0))::value ? 0 : Object::TickLateUpdate) |
+               (decltype(inheritsPhysics<T>(0))::value    ? 0 : Object::TickPhysics)    |
+               (decltype(inheritsRender<T>(0))::value     ? 0 : Object::TickRender)     |
+               (decltype(inheritsGizmo<T>(0))::value      ? 0 : Object::TickGizmo);
+    }
+};
+
+} // namespace detail
+
+namespace detail {
+
+/// PoolAllocator which invalidates the Handles to an Object before
+/// std::allocate_shared destroys it, so they are already invalid while the
+/// Object's destructors run
+template <typename T>
+class ObjectAllocator : public PoolAllocator<T> {
+public:
+    using PoolAllocator<T>::PoolAllocator;
+    template <typename U> struct rebind { typedef ObjectAllocator<U> other; };
+    template <typename U>
+    void destroy(U* p) {
+        if constexpr (std::is_base_of<Tracked, U>::value)
+            TrackedDelete::invalidate(p);
+        p->~U();
+    }
+};
+
+} // namespace detail
+
+/// Makes an Object of type T from the pool for T and records its concrete
+/// TypeId and the Engine callbacks it overrides
+template <typename T, typename ...Args>
+Ptr<T> makeObject(Args&& ...args) {
+    auto object = std::allocate_shared<T>(detail::ObjectAllocator<T>(), std::forward<Args>(args)...);
+    object->m_typeId = typeId<T>();
+    object->m_ticks = detail::TickTraits::overridden<T>();
+    return object;
+}
+
+namespace detail {
+
+/// Returns true if object is a T. The result of dynamic_cast is memoized per
+/// concrete TypeId, so only the first query for each (concrete, T) pair pays
+/// for RTTI. The memo is only read during parallel sections, where queries
+/// it misses fall back to dynamic_cast.
+template <typename T>
+bool isA(const Object* object) {
+    static std::vector<signed char> s_memo;
+    TypeId id = object->getTypeId();
+    if (id == InvalidTypeId)
+        return dynamic_cast<const T*>(object) != nullptr;
+    if (id < s_memo.size() && s_memo[id] >= 0)
+        return s_memo[id] != 0;
+    bool result = dynamic_cast<const T*>(object) != nullptr;
+    // other threads may be reading the memo during a parallel update
+    if (!isDeferring()) {
+        if (id >= s_memo.size())
+            s_memo.resize(id + 1, -1);
+        s_memo[id] = result ? 1 : 0;
+    }
+    return result;
+}
+
+} // namespace detail
+
+/// Handle::as<U>() fast path for down-casts between Object types
+template <typename U, typename T>
+struct HandleCast<U, T, typename std::enable_if<std::is_base_of<Object, T>::value &&
+                                                std::is_base_of<T, U>::value &&
+                                               !std::is_same<T, U>::value>::type> {
+    static U* cast(T* ptr) {
+        if (ptr && detail::isA<U>(ptr))
+            return static_cast<U*>(ptr);
+        return nullptr;
+    }
+};
+
 } // namespace carnot
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <Engine/GameObject.hpp>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace carnot {
+
+/// Recycles GameObjects of type T made as children of a parent GameObject.
+/// Despawned objects are disabled and kept attached to the parent instead of
+/// being destroyed, so their Ids, Components, Transforms and physics bodies
+/// are reused on the next spawn. Once the pool has grown to the peak number
+/// of live objects, spawning and despawning allocate nothing.
+///
+/// onSpawn() is called on every Component, the GameObject and its children
+/// each time an object is handed out (including the first time), and
+/// onDespawn() when it is returned. Coroutines are stopped on despawn.
+///
+/// Constructor arguments for T are given once to the pool, since a respawned
+/// object keeps the state it was made with; reset it in onSpawn() instead.
+template <typename T>
+class ObjectPool : private NonCopyable {
+public:
+
+    /// Constructs a pool whose objects are made as children of parent (args are forwarded to T's constructor)
+    template <typename ...Args> ObjectPool(Handle<GameObject> parent, Args... args);
+
+    /// Makes despawned objects until at least count are pooled
+    void reserve(std::size_t count);
+
+    /// Spawns a pooled object, or makes a new one if none are pooled
+    Handle<T> spawn();
+
+    /// Returns an object to the pool (no-op if already despawned or invalid)
+    void despawn(Handle<T> object);
+
+    /// Returns the number of objects waiting in the pool
+    std::size_t getPooledCount() const;
+
+    /// Returns the number of objects made by the pool that are still alive
+    std::size_t getSize() const;
+
+private:
+
+    /// Makes a new object and tracks it
+    Handle<T> make();
+
+    /// Removes the Handles of objects destroyed outside the pool
+    void compact() const;
+
+    Handle<GameObject> m_parent;                  ///< parent of all pooled objects
+    std::function<Handle<T>(GameObject&)> m_make; ///< makes an object as a child of the parent
+    std::vector<Handle<T>> m_pooled;              ///< despawned objects ready to be respawned
+    mutable std::vector<Handle<T>> m_objects;     ///< objects made by the pool (compacted lazily)
+};
+
+//==============================================================================
+// Template / Inline Function Implementations
+//==============================================================================
+
+template <typename T>
+template <typename ...Args>
+ObjectPool<T>::ObjectPool(Handle<GameObject> parent, Args... args) :
+    m_parent(parent),
+    m_make([args...](GameObject& owner) { return owner.template makeChild<T>(args...); })
+{
+    static_assert(std::is_base_of<GameObject, T>::value, "T must be a GameObject");
+}
+
+template <typename T>
+void ObjectPool<T>::reserve(std::size_t count) {
+    m_pooled.reserve(count);
+    while (m_pooled.size() < count) {
+        Handle<T> object = make();
+        object->despawnAll();
+        object->setEnabled(false);
+        object->m_despawned = true;
+        m_pooled.push_back(object);
+    }
+}
+
+template <typename T>
+Handle<T> ObjectPool<T>::spawn() {
+    // pooled objects may have been destroyed outside the pool
+    std::size_t pooled = m_pooled.size();
+    while (!m_pooled.empty() && !m_pooled.back().isValid())
+        m_pooled.pop_back();
+    if (m_pooled.size() != pooled)
+        compact();
+    if (m_pooled.empty()) {
+        Handle<T> object = make();
+        object->spawnAll();
+        return object;
+    }
+    Handle<T> object = m_pooled.back();
+    m_pooled.pop_back();
+    object->m_despawned = false;
+    object->setEnabled(true);
+    object->spawnAll();
+    return object;
+}
+
+template <typename T>
+void ObjectPool<T>::despawn(Handle<T> object) {
+    if (!object.isValid() || object->m_despawned)
+        return;
+    object->despawnAll();
+    object->setEnabled(false);
+    object->m_despawned = true;
+    m_pooled.push_back(object);
+}
+
+template <typename T>
+std::size_t ObjectPool<T>::getPooledCount() const {
+    return m_pooled.size();
+}
+
+template <typename T>
+std::size_t ObjectPool<T>::getSize() const {
+    compact();
+    return m_objects.size();
+}
+
+template <typename T>
+Handle<T> ObjectPool<T>::make() {
+    assert(m_parent.isValid());
+    // compacting before the vector would grow keeps it bounded by the peak
+    // number of live objects when they are destroyed outside the pool
+    if (m_objects.size() == m_objects.capacity())
+        compact();
+    Handle<T> object = m_make(*m_parent.get());
+    m_objects.push_back(object);
+    return object;
+}
+
+template <typename T>
+void ObjectPool<T>::compact() const {
+    m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(),
+        [](const Handle<T>& object) { return !object.isValid(); }), m_objects.end());
+}
+
+} // namespace carnot
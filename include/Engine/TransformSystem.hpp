@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Utility/Types.hpp>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+
+namespace carnot {
+
+class Transform;
+
+namespace Transforms {
+
+/// Returns the number of live Transforms in the store
+std::size_t getCount();
+/// Returns the number of hierarchy levels after the last sort
+std::size_t getLevelCount();
+
+// Implementation details [internal use only]
+namespace detail {
+void init();
+void update();
+void shutdown();
+
+/// Engine owned structure-of-arrays storage for every Transform. Slots are
+/// physically sorted by hierarchy depth so that one linear pass over the
+/// arrays computes every parent before its children. Transforms created
+/// after the last sort are appended to an unsorted tail which is still
+/// parent-before-child, and the store is re-sorted once the tail, dead
+/// slots or a reparent invalidates the order.
+class Store {
+public:
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// Constructor
+    Store();
+
+    /// Allocates a root slot for a Transform
+    std::size_t allocate(Transform* owner);
+    /// Releases a slot (slots are compacted on the next sort)
+    void release(std::size_t slot);
+    /// Sets the parent slot of a slot (npos for none)
+    void setParent(std::size_t slot, std::size_t parent);
+    /// Marks the local TRS of a slot as changed
+    void makeLocalDirty(std::size_t slot);
+    /// Marks the world matrix of a slot as changed
+    void makeWorldDirty(std::size_t slot);
+    /// Lazily brings the local and world matrices of a slot and its ancestors up to date
+    void validate(std::size_t slot);
+    /// Brings the local and world matrices of a slot up to date, given its parent's are
+    void validateFromParent(std::size_t slot);
+    /// Computes every dirty local and world matrix in a single parent-before-child pass
+    void updateAll();
+
+    /// Returns the number of live slots
+    std::size_t count() const;
+    /// Returns the number of hierarchy levels after the last sort
+    std::size_t levelCount() const;
+
+public:
+
+    std::vector<Transform*>   owner;         ///< owning Transform (nullptr if dead)
+    std::vector<std::size_t>  parent;        ///< parent slot (npos if none)
+
+    std::vector<Vector2f>     position;      ///< local position
+    std::vector<Vector2f>     scale;         ///< local scale
+    std::vector<Vector2f>     origin;        ///< local origin
+    std::vector<float>        rotation;      ///< local rotation in degrees
+
+    std::vector<float>        l00, l01, l02; ///< local affine matrix, first row
+    std::vector<float>        l10, l11, l12; ///< local affine matrix, second row
+    std::vector<float>        w00, w01, w02; ///< world affine matrix, first row
+    std::vector<float>        w10, w11, w12; ///< world affine matrix, second row
+
+    std::vector<std::uint8_t> localDirty;    ///< local TRS changed since local matrix computed
+    std::vector<std::uint8_t> worldDirty;    ///< local matrix or parent slot changed
+    std::vector<std::size_t>  worldVersion;  ///< generation the world matrix was computed at
+    std::vector<std::size_t>  parentVersion; ///< parent generation the world matrix was computed from
+
+private:
+
+    /// Computes the local matrix of a slot from its TRS
+    void computeLocal(std::size_t slot);
+    /// Computes the world matrix of one slot from its (up to date) parent
+    void computeWorld(std::size_t slot, std::size_t generation);
+    /// Composes the world matrices of a sorted level [begin, end)
+    void composeLevel(std::size_t begin, std::size_t end, std::size_t generation);
+    /// Sorts slots by depth, drops dead slots and rebuilds level ranges
+    void sort();
+
+private:
+
+    std::vector<std::size_t> m_levels;     ///< start offset of each sorted level (last = end of sorted range)
+    std::atomic<std::size_t> m_generation; ///< global world matrix generation
+    std::size_t              m_dead;       ///< number of released slots awaiting compaction
+    bool                     m_sorted;     ///< false if a reparent broke the depth ordering
+    std::atomic<bool>        m_dirty;      ///< true if anything changed since the last pass
+    std::vector<float>       m_scratch;    ///< gathered parent matrices and masks for composeLevel
+};
+
+/// Returns the Transform store
+Store& store();
+
+} // namespace detail
+} // namespace Transforms
+} // namespace carnot
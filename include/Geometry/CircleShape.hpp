@@ -19,7 +19,9 @@ public:
 
     std::size_t getSmoothness() const;
 
-    void transform(const Matrix3x3& matrix) override;
+    using Shape::transform;
+
+    void transform(const Affine& matrix) override;
 
 private:
     void updateCircleShape();
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Utility/Types.hpp>
+#include <Utility/Handle.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace carnot {
+
+class Shape;
+
+/// Immutable indexed triangle mesh of a Shape
+struct Mesh {
+    std::vector<Vector2f> vertices;      ///< outer contour followed by each hole
+    std::vector<std::size_t> contours;   ///< number of vertices in each contour
+    std::vector<std::uint32_t> indices;  ///< every three indices make a triangle
+    std::uint64_t hash;                  ///< hash of vertices and contours
+};
+
+/// Global cache of triangulated Shapes keyed by a hash of their geometry, so
+/// that identical Shapes (same vertices and holes) are triangulated once and
+/// share a Mesh. Meshes are evicted when the last reference is released.
+namespace MeshCache {
+
+    /// Gets the shared Mesh for a Shape, triangulating it on a cache miss
+    /// (empty if the Shape has fewer than three vertices)
+    Ptr<const Mesh> get(const Shape& shape);
+
+    /// Gets the number of Meshes currently cached
+    std::size_t getMeshCount();
+
+    /// Gets the number of lookups which found a cached Mesh
+    std::size_t getHitCount();
+
+    /// Gets the number of lookups which triangulated a new Mesh
+    std::size_t getMissCount();
+
+} // namespace MeshCache
+
+} // namespace carnot
@@ -2,6 +2,7 @@
 
 #include <Utility/Types.hpp>
 #include <Utility/Cacheable.hpp>
+#include <Utility/Affine.hpp>
 #include <vector>
 
 namespace carnot {
@@ -67,7 +68,10 @@ public:
     void scale(const Vector2f& scale);
 
     /// Transform all points
-    virtual void transform(const Matrix3x3& matrix);
+    virtual void transform(const Affine& matrix);
+
+    /// Transform all points
+    void transform(const Matrix3x3& matrix);
 
     /// Sets the radius associated with a point
     void setRadius(std::size_t index, float radius, std::size_t smoothness = 10);
@@ -122,6 +126,11 @@ public:
     /// Returns true if the Shape is convex, false if concave
     bool isConvex() const;
 
+    /// Triangulates the Shape's vertices and holes, every three returned
+    /// points making a triangle (empty if there are fewer than three vertices).
+    /// Identical Shapes share one triangulation through the MeshCache
+    std::vector<Vector2f> triangulate() const;
+
 public:
 
     /// Offset type options
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Graphics/Components/Renderer.hpp>
+#include <Graphics/RetainedVertexBuffer.hpp>
+#include <Geometry/Shape.hpp>
+#include <Geometry/MeshCache.hpp>
+
+namespace carnot {
+
+/// Renderer which draws many copies (instances) of one Shape in a single draw
+/// call. The Shape is triangulated once, and each instance has its own
+/// transform (relative to the GameObject), color and enabled flag.
+class InstancedShapeRenderer : public Renderer {
+public:
+
+    /// Constructor
+    InstancedShapeRenderer(GameObject& gameObject);
+
+    /// Constructor which takes a Shape
+    InstancedShapeRenderer(GameObject& gameObject, Ptr<Shape> shape);
+    /// Destructor
+    ~InstancedShapeRenderer();
+
+    /// Sets the Shape drawn by every instance
+    void setShape(Ptr<Shape> shape);
+
+    /// Gets the Shape drawn by every instance
+    Ptr<Shape> getShape() const;
+
+    /// Adds an enabled instance and returns its index
+    std::size_t addInstance(const Vector2f& position, const Color& color = Color::White);
+
+    /// Sets the number of instances (new instances are at the origin, white and enabled)
+    void setInstanceCount(std::size_t count);
+
+    /// Gets the number of instances
+    std::size_t getInstanceCount() const;
+
+    /// Sets the transform of an instance (relative to the GameObject)
+    void setInstanceTransform(std::size_t index, const Affine& transform);
+
+    /// Sets the position, rotation (degrees) and scale of an instance
+    void setInstanceTransform(std::size_t index, const Vector2f& position, float rotation = 0.0f, const Vector2f& scale = Vector2f(1.0f, 1.0f));
+
+    /// Gets the transform of an instance
+    const Affine& getInstanceTransform(std::size_t index) const;
+
+    /// Sets the Color of an instance
+    void setInstanceColor(std::size_t index, const Color& color);
+
+    /// Gets the Color of an instance
+    const Color& getInstanceColor(std::size_t index) const;
+
+    /// Shows or hides an instance
+    void setInstanceEnabled(std::size_t index, bool enabled);
+
+    /// Returns true if an instance is shown
+    bool isInstanceEnabled(std::size_t index) const;
+
+    /// Gets the local bounding rectangle of the enabled instances
+    virtual FloatRect getLocalBounds() const override;
+
+    /// Gets the global bounding rectangle of the enabled instances
+    virtual FloatRect getWorldBounds() const override;
+
+protected:
+
+    /// Renders all instances to RenderTarget
+    virtual void render(RenderTarget& target) const override;
+
+private:
+
+    void updateVertexArray() const;
+    /// Expands the mesh for instances [begin, end) and records their bounds
+    void expandInstances(std::size_t begin, std::size_t end) const;
+    /// Recomputes the bounds from the bounds of every instance
+    void updateBounds() const;
+    /// Marks an instance changed
+    void invalidateInstance(std::size_t index);
+    /// Forgets the changed instances
+    void clearDirtyInstances() const;
+
+private:
+
+    /// Packed per-instance data
+    struct Instance {
+        Affine transform;
+        Color  color;
+        bool   enabled;
+        mutable bool dirty; ///< in m_dirtyInstances?
+    };
+
+    Ptr<Shape> m_shape;
+    std::size_t m_shapeWatcher;                  ///< watchCache id on m_shape
+    mutable std::size_t m_cacheAge;
+    mutable Ptr<const Mesh> m_mesh;              ///< shared triangulation of the Shape
+    mutable FloatRect m_meshBounds;              ///< bounds of m_mesh
+    std::vector<Instance> m_instances;
+    mutable std::vector<Vertex> m_vertexArray;   ///< mesh expanded for every instance
+    mutable std::vector<FloatRect> m_instanceBounds; ///< bounds of each instance when expanded (negative size if disabled)
+    mutable RetainedVertexBuffer m_vertexBuffer;
+    mutable FloatRect m_bounds;
+    mutable bool m_needsUpdate;                  ///< every instance must be expanded?
+    mutable std::vector<std::uint32_t> m_dirtyInstances; ///< instances changed since the last expansion
+};
+
+} // namespace carnot
@@ -2,6 +2,7 @@
 
 #include <Graphics/Components/Renderer.hpp>
 #include <Graphics/Gradient.hpp>
+#include <Graphics/RetainedVertexBuffer.hpp>
 #include <Geometry/Shape.hpp>
 #include <Utility/Sequence.hpp>
 
@@ -63,12 +64,14 @@ protected:
 
 private:
 
+    void updateCache() const;
     void updateBounds() const;
     void updateColor() const;
 
 private:
 
     mutable std::vector<Vertex> m_vertexArray;
+    mutable RetainedVertexBuffer m_vertexBuffer;
     Color m_color;
     mutable FloatRect m_bounds;
     mutable bool m_needsUpdate;
@@ -2,9 +2,17 @@
 
 #include <Utility/Types.hpp>
 #include <Engine/Component.hpp>
+#include <cstdint>
 
 namespace carnot {
 
+class RenderBatch;
+
+namespace detail {
+/// Adds to the number of vertex bytes uploaded this frame [internal use only]
+void countUploadedBytes(std::size_t bytes);
+} // namespace detail
+
 class Renderer : public Component {
 public:
 
@@ -33,25 +41,64 @@ public:
 
     /// Gets the number of Renderers alive
     static std::size_t getRendererCount();
+    /// Gets the number of vertex bytes uploaded to the GPU to render the last frame
+    static std::size_t getUploadedBytes();
+    /// Gets the number of Renderers drawn in the last frame, summed over all Views
+    static std::size_t getDrawnCount();
+    /// Gets the number of Renderers culled in the last frame, summed over all Views
+    static std::size_t getCulledCount();
+    /// Gets the milliseconds spent culling and sorting Renderers in the last frame
+    static float getCullingTime();
 
 protected:
 
     friend class Engine;
+    friend class GameObject;
 
-    /// Ques this Renderer
-    void onRender(RenderQue& que) override;
     /// Renders shape bounding box and wireframe
     virtual void onGizmo() override;    
+    /// Queues the world bounds of the Renderer to be recomputed before the
+    /// next frame is culled. Transform changes are picked up automatically;
+    /// derived Renderers call this whenever their local bounds change.
+    void invalidateCulling();
+    /// Makes the Renderer compare its local bounds every frame instead, for
+    /// Renderers whose bounds can change without invalidateCulling (e.g. from
+    /// a public member)
+    void pollCulling();
+    /// Finishes counting the vertex bytes uploaded for a frame and records the
+    /// number of Renderers drawn and culled [called by Engine]
+    static void endFrame(std::size_t drawn, std::size_t culled, float cullingTime);
+    /// Brings the culling grid up to date, recomputing only the world bounds
+    /// of Renderers invalidated since the last frame [called by Engine]
+    static void updateCulling(float cellSize);
+    /// Appends the listed Renderers which overlap rect to out (in no particular
+    /// order) and returns the number which don't [called by Engine]
+    static std::size_t findVisible(const FloatRect& rect, std::vector<const Renderer*>& out);
     /// Must be overriden to draw the Renderer
     virtual void render(RenderTarget& target) const = 0;
+    /// Adds the Renderer to a RenderBatch instead of drawing it, returns false
+    /// if the Renderer can't be batched and must be drawn with render() (default)
+    virtual bool batch(RenderBatch& batch) const;
 
 protected:
 
     mutable RenderStates m_states;  ///< RenderStates
 
+private:
+
+    /// Adds the Renderer to the culling grid, or removes it [called by GameObject]
+    void setListed(bool listed);
+
 private:
 
     std::size_t m_layer;   ///< the render layer
+    std::uint32_t m_cullKey;      ///< key in the culling grid, or CullGrid::npos if not listed
+    std::uint32_t m_drawOrder;    ///< position among the listed Renderers in tree order
+    std::size_t   m_dirtyIndex;   ///< index in the invalidated Renderers, or npos
+    std::size_t   m_pollIndex;    ///< index in the polled Renderers, or npos
+    bool          m_polled;       ///< local bounds compared every frame?
+    FloatRect     m_cullBounds;   ///< local bounds when last gridded (polled Renderers only)
+    std::size_t   m_transformConnection; ///< connection to Transform::onChanged
 
 };
 
@@ -2,7 +2,9 @@
 
 #include <Graphics/Components/Renderer.hpp>
 #include <Graphics/Effect.hpp>
+#include <Graphics/RetainedVertexBuffer.hpp>
 #include <Geometry/Shape.hpp>
+#include <Geometry/MeshCache.hpp>
 
 namespace carnot {
 
@@ -15,6 +17,8 @@ public:
 
     /// Constructor which takes a Shape
     ShapeRenderer(GameObject& gameObject, Ptr<Shape> shape);
+    /// Destructor
+    ~ShapeRenderer();
 
     /// Sets the shape to be rendered by reference
     void setShape(const Shape& shape);
@@ -68,11 +72,14 @@ protected:
 
     /// Renders the Shape to RenderTarget
     virtual void render(RenderTarget& target) const override;
+    /// Adds the Shape to a RenderBatch
+    virtual bool batch(RenderBatch& batch) const override;
     /// Renders shape bounding box and wireframe
     virtual void onGizmo() override;
 
 private:
 
+    void updateCache() const;
     void updateVertexArray() const;
     void updateTexCoords() const;
     void updateFillColors() const;
@@ -80,8 +87,11 @@ private:
 private:
 
     Ptr<Shape> m_shape; 
+    std::size_t m_shapeWatcher;      ///< watchCache id on m_shape
     mutable std::size_t m_cacheAge;
+    mutable Ptr<const Mesh> m_mesh;
     mutable std::vector<Vertex> m_vertexArray;
+    mutable RetainedVertexBuffer m_vertexBuffer;
     Ptr<Texture> m_texture;
     IntRect m_textureRect;
     Color m_color;
@@ -19,12 +19,14 @@ public:
 
 public:
 
-    Sprite sprite;  ///< Sprite to be rendered
+    Sprite sprite;  ///< Sprite to be rendered (its bounds are compared every frame for culling)
 
 protected:
 
     /// Renders the Sprite to RenderTarget
     virtual void render(RenderTarget& target) const override;
+    /// Adds the Sprite to a RenderBatch
+    virtual bool batch(RenderBatch& batch) const override;
 };
 
 } // namespace carnot
@@ -2,6 +2,7 @@
 
 #include <Graphics/Components/Renderer.hpp>
 #include <Graphics/Gradient.hpp>
+#include <Graphics/RetainedVertexBuffer.hpp>
 #include <Geometry/Shape.hpp>
 
 namespace carnot {
@@ -87,12 +88,15 @@ protected:
 
     /// Renders the Shape to RenderTarget
     virtual void render(RenderTarget& target) const override;
+    /// Adds the Stroke to a RenderBatch
+    virtual bool batch(RenderBatch& batch) const override;
 
     /// Renders stroke bounding box and skeleton
     virtual void onGizmo() override;
 
 private:
 
+    void updateCache() const;
     void updateVertexArray() const;
     void updateColor() const;
     void updateBounds() const;
@@ -109,6 +113,7 @@ private:
     float m_miterLimit;
 
     mutable std::vector<Vertex> m_vertexArray;
+    mutable RetainedVertexBuffer m_vertexBuffer;
     mutable FloatRect m_bounds;
     mutable bool m_needsUpdate;
 
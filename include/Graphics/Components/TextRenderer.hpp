@@ -19,7 +19,7 @@ public:
 
 public:
 
-    Text text;  ///< Text to be rendered
+    Text text;  ///< Text to be rendered (its bounds are compared every frame for culling)
 
 protected:
 
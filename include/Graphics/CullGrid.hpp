@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Utility/Types.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace carnot {
+
+/// Loose grid spatial hash of bounding rectangles used to cull Renderers
+/// against View rectangles. Each rectangle is stored once, in the cell
+/// containing its center, so a query only visits the cells around the query
+/// rectangle. Rectangles larger than a cell are kept in a separate list which
+/// every query tests. Rectangles persist between queries, so only those which
+/// moved need to be updated.
+class CullGrid : private NonCopyable {
+public:
+
+    /// Key which identifies no rectangle
+    static constexpr std::uint32_t npos = 0xFFFFFFFF;
+
+    /// Constructor
+    CullGrid();
+
+    /// Sets the cell width and height, rehashing the rectangles if it changed
+    void setCellSize(float cellSize);
+
+    /// Gets the cell width and height
+    float getCellSize() const;
+
+    /// Adds a rectangle and returns the key which identifies it
+    std::uint32_t insert(const FloatRect& bounds);
+
+    /// Moves the rectangle identified by key
+    void update(std::uint32_t key, const FloatRect& bounds);
+
+    /// Removes the rectangle identified by key, which may then be reused
+    void remove(std::uint32_t key);
+
+    /// Removes all rectangles
+    void clear();
+
+    /// Appends the keys of rectangles which overlap rect to out (in no particular order)
+    void query(const FloatRect& rect, std::vector<std::uint32_t>& out) const;
+
+    /// Gets the number of rectangles in the grid
+    std::size_t size() const;
+
+private:
+
+    struct Item {
+        FloatRect bounds;
+        std::int32_t x, y;   ///< cell containing the center
+        std::uint32_t list;  ///< hash bucket holding the item, LARGE or FREE
+        std::uint32_t index; ///< position in that list
+    };
+
+    bool isLarge(const FloatRect& bounds, float& cx, float& cy) const;
+    void place(std::uint32_t key);
+    void unplace(std::uint32_t key);
+    void rehash(std::size_t bucketCount);
+    std::size_t bucket(std::int32_t x, std::int32_t y) const;
+
+private:
+
+    static constexpr std::uint32_t LARGE = 0xFFFFFFFE;
+    static constexpr std::uint32_t FREE  = 0xFFFFFFFF;
+
+    float m_cellSize;                                ///< cell width and height
+    float m_invCellSize;                             ///< 1 / m_cellSize
+    std::vector<Item> m_items;                       ///< items by key
+    std::vector<std::uint32_t> m_free;               ///< keys of removed items
+    std::vector<std::vector<std::uint32_t>> m_buckets; ///< keys of the items no larger than a cell, by hash bucket
+    std::vector<std::uint32_t> m_large;              ///< keys of the items larger than a cell
+};
+
+} // namespace carnot
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Utility/Types.hpp>
+#include <Utility/Affine.hpp>
+#include <vector>
+
+namespace carnot {
+
+/// Merges consecutive draws of triangles which share a texture, shader and
+/// blend mode into a single draw call. Vertices are transformed to world space
+/// as they are added, so draws keep their order.
+class RenderBatch : private NonCopyable {
+public:
+
+    /// Renderers with more vertices than this draw from their own retained
+    /// VertexBuffer, since transforming and uploading them every frame costs
+    /// more than the draw call saved by batching them
+    static constexpr std::size_t MAX_VERTICES = 1024;
+
+    /// Constructor
+    RenderBatch();
+
+    /// Begins batching draws to a RenderTarget
+    void begin(RenderTarget& target);
+
+    /// Adds triangles (sf::Triangles) to be drawn with RenderStates, flushing
+    /// the pending triangles first if their texture, shader or blend mode differ.
+    /// Vertices are moved to world space by transform; states.transform is ignored
+    void draw(const Vertex* vertices, std::size_t count, const Affine& transform, const RenderStates& states);
+
+    /// Draws the pending triangles to the RenderTarget
+    void flush();
+
+private:
+
+    RenderTarget* m_target;         ///< target being drawn to
+    RenderStates m_states;          ///< states of the pending triangles (identity transform)
+    std::vector<Vertex> m_vertices; ///< pending triangles in world coordinates
+    std::vector<Vector2f> m_points; ///< positions of the vertices being added
+};
+
+} // namespace carnot
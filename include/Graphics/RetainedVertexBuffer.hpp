@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Utility/Types.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <vector>
+
+namespace carnot {
+
+/// A VertexBuffer kept on the GPU which is only uploaded when its vertices
+/// change. Buffers uploaded on consecutive frames switch to the Stream usage
+/// hint. Falls back to client side arrays where VertexBuffers are unavailable.
+class RetainedVertexBuffer {
+public:
+
+    /// Constructor
+    RetainedVertexBuffer(sf::PrimitiveType type, sf::VertexBuffer::Usage usage = sf::VertexBuffer::Static);
+
+    /// Marks the vertices changed so that they are uploaded on the next draw
+    void invalidate();
+
+    /// Marks count vertices starting at first changed so that only they are
+    /// uploaded on the next draw (unless the vertex count changes). Each range
+    /// is uploaded separately, so callers should coalesce nearby changes.
+    void invalidate(std::size_t first, std::size_t count);
+
+    /// Draws vertices, uploading them first if they changed since the last draw
+    void draw(RenderTarget& target, const std::vector<Vertex>& vertices, const RenderStates& states);
+
+private:
+
+    sf::VertexBuffer m_buffer;   ///< GPU vertex buffer
+    std::size_t m_count;         ///< number of vertices uploaded
+    std::size_t m_uploadFrame;   ///< frame of the last upload
+    bool m_dirty;                ///< vertices need uploading?
+    std::vector<std::pair<std::size_t, std::size_t>> m_ranges; ///< [begin, end) of the changed vertex ranges
+};
+
+} // namespace carnot
@@ -12,6 +12,12 @@ class CircleShape;
 class CollisionListener;
 class RigidBody;
 
+namespace Physics {
+namespace detail {
+void update();
+} // namespace detail
+} // namespace Physics
+
 struct Collision {
     RigidBody* other;
 };
@@ -49,6 +55,11 @@ public:
     /// Gets the global rotation of the Object
     float getRotation() const;
 
+    /// Sets whether the Transform is interpolated between physics steps (default true)
+    void setInterpolated(bool interpolated);
+    /// Returns true if the Transform is interpolated between physics steps
+    bool isInterpolated() const;
+
     /// Sets the BodyType
     void setBodyType(BodyType type);
     /// Gets the BodyType
@@ -145,17 +156,34 @@ public:
 
 private:
 
-    /// Syncs RigidBody position/rotation with Transform
+    /// Syncs RigidBody position/rotation with Transform and records the pose as synced
     void syncWithTransform();
-    /// Updates GameObject transform
-    void onPhysics() override;
+    /// Records the body pose before a physics step
+    void storePreviousPose();
+    /// Writes the body pose to the Transform, interpolated between the last
+    /// two steps, if it changed [called by PhysicsSystem for awake bodies,
+    /// and for sleeping ones whose Transform something else moved]
+    void syncTransform();
+    /// Resets motion and reactivates the body
+    void onSpawn() override;
+    /// Deactivates the body (removes it from the broad-phase without destroying it)
+    void onDespawn() override;
 
 private:
 
     friend class Collider;
+    friend void Physics::detail::update();
 
     b2Body* m_body;                 ///< Physics system body
     std::vector<char>     m_mask;   ///< Shape type mask
+    Vector2f m_prevPosition;        ///< body position before the last step (physics units)
+    float    m_prevAngle;           ///< body angle before the last step (radians)
+    bool     m_interpolated;        ///< interpolate Transform between steps?
+    bool     m_syncPending;         ///< Transform needs a sync even if the body sleeps
+    Vector2f m_syncedPosition;      ///< position last written to the Transform
+    float    m_syncedAngle;         ///< rotation last written to the Transform
+    std::size_t m_syncedVersion;    ///< Transform version after the last write (changes if anything else moves it)
+    std::size_t m_transformConnection; ///< connection to Transform::onChanged
 };
 
 
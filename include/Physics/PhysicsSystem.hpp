@@ -14,6 +14,26 @@ namespace Physics {
 
 /// Set PhysicsSystem step time (default = 1/60);
 void setDeltaTime(float dt);
+/// Gets the PhysicsSystem step time
+float getDeltaTime();
+/// Sets the max number of steps per frame taken to catch up with real time (default = 5)
+void setMaxSubSteps(std::size_t steps);
+/// Gets the max number of steps per frame taken to catch up with real time
+std::size_t getMaxSubSteps();
+/// Sets the constraint solver velocity and position iterations per step (default = 6, 2)
+void setIterations(int velocityIterations, int positionIterations);
+/// Gets the constraint solver velocity iterations per step
+int getVelocityIterations();
+/// Gets the constraint solver position iterations per step
+int getPositionIterations();
+/// Gets the fraction of a step that real time is ahead of the simulation, in [0,1)
+float getAlpha();
+/// Gets the number of steps taken during the last frame
+std::size_t getStepCount();
+/// Sets whether independent islands of bodies are solved on the Engine JobSystem (default = true)
+void setMultithreaded(bool multithreaded);
+/// Returns true if independent islands of bodies are solved on the Engine JobSystem
+bool isMultithreaded();
 
 /// Sets the global gravity vector (default = <0, 1000>)
 void setGravity(const Vector2f& g);
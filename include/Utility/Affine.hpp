@@ -0,0 +1,118 @@
+#pragma once
+
+#include <Utility/Types.hpp>
+#include <vector>
+
+namespace carnot {
+
+/// Compact 2D affine transformation stored as six floats:
+///
+///     [ a  b  tx ]
+///     [ c  d  ty ]
+///     [ 0  0  1  ]
+///
+/// Engine math is 2D, so this is used internally in place of Matrix3x3
+/// (a 16 float sf::Transform), which is only built at draw submission.
+/// Multiply, inverse and batch point transforms use SSE/AVX when available.
+class Affine {
+public:
+
+    /// Constructs an identity transformation
+    Affine();
+    /// Constructs from the six matrix elements
+    Affine(float a, float b, float tx, float c, float d, float ty);
+    /// Constructs from a Matrix3x3 (the projective row is ignored)
+    explicit Affine(const Matrix3x3& matrix);
+
+    /// Converts to a Matrix3x3 for submission to SFML
+    Matrix3x3 toMatrix3x3() const;
+    /// Gets the six matrix elements {a, b, c, d, tx, ty}
+    const float* getMatrix() const;
+
+    /// Returns the inverse transformation (identity if not invertible)
+    Affine getInverse() const;
+    /// Combines this transformation with another (i.e. this = this * other)
+    Affine& combine(const Affine& other);
+
+    /// Combines with a translation
+    Affine& translate(float x, float y);
+    /// Combines with a translation
+    Affine& translate(const Vector2f& offset);
+    /// Combines with a rotation in degrees
+    Affine& rotate(float angle);
+    /// Combines with a scaling
+    Affine& scale(float scaleX, float scaleY);
+    /// Combines with a scaling
+    Affine& scale(const Vector2f& factors);
+
+    /// Transforms a point
+    Vector2f transformPoint(float x, float y) const;
+    /// Transforms a point
+    Vector2f transformPoint(const Vector2f& point) const;
+    /// Transforms a rectangle and returns its axis aligned bounding rectangle
+    FloatRect transformRect(const FloatRect& rect) const;
+    /// Transforms count points from in to out (in and out may alias)
+    void transformPoints(const Vector2f* in, Vector2f* out, std::size_t count) const;
+    /// Transforms all points from in to out, resizing out as needed (in and out may alias)
+    void transformPoints(const std::vector<Vector2f>& in, std::vector<Vector2f>& out) const;
+
+    static const Affine Identity; ///< the identity transformation
+
+private:
+
+    float m_matrix[6]; ///< {a, b, c, d, tx, ty}
+};
+
+/// Combines two transformations
+Affine operator*(const Affine& left, const Affine& right);
+/// Combines two transformations
+Affine& operator*=(Affine& left, const Affine& right);
+/// Transforms a point
+Vector2f operator*(const Affine& left, const Vector2f& right);
+
+//==============================================================================
+// Template / Inline Function Implementations
+//==============================================================================
+
+inline Affine::Affine() :
+    m_matrix{1.f, 0.f, 0.f, 1.f, 0.f, 0.f}
+{ }
+
+inline Affine::Affine(float a, float b, float tx, float c, float d, float ty) :
+    m_matrix{a, b, c, d, tx, ty}
+{ }
+
+inline const float* Affine::getMatrix() const {
+    return m_matrix;
+}
+
+inline Vector2f Affine::transformPoint(float x, float y) const {
+    return Vector2f(m_matrix[0] * x + m_matrix[1] * y + m_matrix[4],
+                    m_matrix[2] * x + m_matrix[3] * y + m_matrix[5]);
+}
+
+inline Vector2f Affine::transformPoint(const Vector2f& point) const {
+    return transformPoint(point.x, point.y);
+}
+
+inline Affine& Affine::translate(const Vector2f& offset) {
+    return translate(offset.x, offset.y);
+}
+
+inline Affine& Affine::scale(const Vector2f& factors) {
+    return scale(factors.x, factors.y);
+}
+
+inline Affine operator*(const Affine& left, const Affine& right) {
+    return Affine(left).combine(right);
+}
+
+inline Affine& operator*=(Affine& left, const Affine& right) {
+    return left.combine(right);
+}
+
+inline Vector2f operator*(const Affine& left, const Vector2f& right) {
+    return left.transformPoint(right);
+}
+
+} // namespace carnot
@@ -1,5 +1,7 @@
 #pragma once
 #include <cstddef>
+#include <functional>
+#include <vector>
 
 namespace carnot {
 
@@ -10,12 +12,26 @@ public:
     /// Default constructor
     Cacheable(bool stale = true);
 
+    /// Copy constructor (watchers aren't copied)
+    Cacheable(const Cacheable& other);
+
+    /// Copy assignment (keeps and notifies this object's watchers)
+    Cacheable& operator=(const Cacheable& other);
+
     /// Returns the age of the cache
     std::size_t cacheAge() const;
 
     /// Checks if an external age is current with the cache's age
     bool cacheCurrent(std::size_t& age) const;
 
+    /// Calls callback when the cached state goes stale after having been
+    /// updated, so that holders of a shared object learn it changed without
+    /// polling. Returns an id for unwatchCache.
+    std::size_t watchCache(std::function<void()> callback) const;
+
+    /// Stops calling a callback added with watchCache
+    void unwatchCache(std::size_t id) const;
+
 protected:
 
     /// Instructs the object to update its cached state if stale
@@ -27,9 +43,15 @@ protected:
     /// Flags the cached state as stale
     void makeCacheStale() const;
 
+private:
+    /// Calls the watchers
+    void notifyWatchers() const;
+
 private:
     mutable std::size_t m_age; ///< age of cache, increments with each update
     mutable bool m_stale;      ///< true if the cache has become invalidated
+    mutable std::vector<std::pair<std::size_t, std::function<void()>>> m_watchers; ///< callbacks by id
+    mutable std::size_t m_nextWatcher; ///< id of the next watcher
 };
     
 } // carnot
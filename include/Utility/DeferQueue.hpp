@@ -0,0 +1,25 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace carnot {
+namespace detail {
+
+/// Calls deferred out of a parallel section, replayed serially at its merge
+/// point in the order they were issued
+typedef std::vector<std::function<void()>> DeferQueue;
+
+/// Returns the calling thread's active DeferQueue (nullptr outside parallel sections)
+inline DeferQueue*& deferQueue() {
+    thread_local DeferQueue* t_queue = nullptr;
+    return t_queue;
+}
+
+/// Returns true if the calling thread is inside a parallel section
+inline bool isDeferring() {
+    return deferQueue() != nullptr;
+}
+
+} // namespace detail
+} // namespace carnot
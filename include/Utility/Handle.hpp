@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <cassert>
+#include <type_traits>
+#include <cstdint>
 
 namespace carnot {
 
@@ -19,21 +21,120 @@ inline Ptr<T> make(Args... args) {
     return std::make_shared<T>(std::forward<Args>(args)...);
 }
 
+//==============================================================================
+// TRACKED
+//==============================================================================
+
+namespace detail {
+
+/// Entry in the global handle slot table. Slots live in fixed size blocks
+/// and are never moved or freed, so Handles may point to them directly.
+struct HandleSlot {
+    std::uint32_t generation; ///< incremented each time the slot is released
+    std::uint32_t nextFree;   ///< next slot in the free list
+};
+
+struct TrackedDelete;
+
+} // namespace detail
+
+/// Base class for types referenced by Handle. Each Tracked instance owns a
+/// slot in a global generational table; destroying the instance bumps the
+/// slot's generation, which invalidates all Handles to it without touching
+/// any reference counts. Slots are acquired and released under a lock, but
+/// Handles are not synchronized with the destruction of their object.
+///
+/// Objects deleted through detail::TrackedDelete (or made by makeObject)
+/// invalidate their Handles before their most derived destructor runs;
+/// others only do so once ~Tracked runs, after all derived destructors.
+///
+/// Tracked derives from std::enable_shared_from_this<Tracked> so that
+/// Handle::lock() can find the owning Ptr. Derived types must not also
+/// derive from std::enable_shared_from_this<Self>; use Handle(this).lock()
+/// in place of shared_from_this().
+class Tracked : public std::enable_shared_from_this<Tracked> {
+public:
+    /// Constructor (acquires a slot)
+    Tracked();
+    /// Copy constructor (acquires a new slot rather than sharing one)
+    Tracked(const Tracked& other);
+    /// Copy assignment (keeps the existing slot)
+    Tracked& operator=(const Tracked& other);
+    /// Destructor (releases the slot and invalidates all Handles)
+    ~Tracked();
+    /// Returns the number of Tracked instances alive
+    static std::size_t getTrackedCount();
+private:
+    template <typename T> friend class Handle;
+    friend struct detail::TrackedDelete;
+    /// Invalidates all Handles to this instance ahead of its destruction
+    void invalidateHandles();
+    detail::HandleSlot* m_handleSlot; ///< slot owned by this instance
+    std::uint32_t m_handleIndex;      ///< index of the slot in the table
+};
+
+namespace detail {
+
+/// Deleter for Ptrs to Tracked objects which invalidates their Handles
+/// before any destructor runs, so Handles never reach a partially
+/// destroyed object
+struct TrackedDelete {
+    template <typename T>
+    void operator()(T* object) const {
+        if (object)
+            invalidate(object);
+        delete object;
+    }
+    /// Invalidates all Handles to a Tracked object about to be destroyed
+    static void invalidate(Tracked* tracked) {
+        tracked->invalidateHandles();
+    }
+};
+
+} // namespace detail
+
+//==============================================================================
+// HANDLE CAST
+//==============================================================================
+
+/// Casts a T* to a U* for Handle::as<U>(). Up-casts are resolved at compile
+/// time; other casts fall back to dynamic_cast unless a specialization
+/// provides a faster path (see Object.hpp).
+template <typename U, typename T, typename Enable = void>
+struct HandleCast {
+    static U* cast(T* ptr) {
+        if constexpr (std::is_base_of<U, T>::value)
+            return static_cast<U*>(ptr);
+        else
+            return dynamic_cast<U*>(ptr);
+    }
+};
+
 //==============================================================================
 // HANDLE
 //==============================================================================
 
-/// Handle class
+/// Non-owning reference to a Tracked object. Validity checks and access are
+/// a single generation compare against the object's slot, so Handles may be
+/// freely copied and dereferenced in hot code. Use lock() to get shared
+/// ownership when the object is owned by a Ptr.
 template <typename T>
 class Handle {
 public:
 
-
     /// Constructs an invalid Handle
     Handle();
 
-    /// Constructs a valid Handle
-    Handle(WkPtr<T> wkPtr);
+    /// Constructs a Handle to an object owned by a Ptr
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    Handle(const Ptr<U>& ptr);
+
+    /// Constructs a Handle to an object owned by a Ptr
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    Handle(const WkPtr<U>& wkPtr);
+
+    /// Constructs a Handle directly from an object pointer (may be nullptr)
+    explicit Handle(T* object);
 
     /// Constructs a valid Handle from another Handle
     template <typename U> Handle(Handle<U> handle);
@@ -48,9 +149,9 @@ public:
     operator bool() const;
 
     /// Returns this Handle cast as another Handle type
-    template <typename U> Handle<U> as();
+    template <typename U> Handle<U> as() const;
 
-    /// Returns a shared pointer from Handle
+    /// Returns a shared pointer from Handle (empty if the Object is not owned by a Ptr)
     Ptr<T> lock() const;
 
     /// Get underlying raw pointer (use sparingly!)
@@ -58,7 +159,11 @@ public:
 
 private:
 
-    WkPtr<T> m_wkPtr;  ///< weak pointer to Object
+    template <typename U> friend class Handle;
+
+    T* m_ptr;                          ///< pointer to Object
+    const detail::HandleSlot* m_slot;  ///< slot of the Object
+    std::uint32_t m_generation;        ///< generation of the slot when the Handle was made
 
 };
 
@@ -84,35 +189,76 @@ bool operator !=(const Handle<T>& lhs, const Handle<U>& rhs);
 
 template <typename T>
 Handle<T>::Handle() :
-    m_wkPtr()
+    m_ptr(nullptr),
+    m_slot(nullptr),
+    m_generation(0)
+{
+
+}
+
+template <typename T>
+Handle<T>::Handle(T* object) :
+    m_ptr(object),
+    m_slot(nullptr),
+    m_generation(0)
+{
+    static_assert(std::is_base_of<Tracked, T>::value, "Handle<T> requires T to derive from Tracked");
+    if (object) {
+        const Tracked* tracked = object;
+        m_slot = tracked->m_handleSlot;
+        m_generation = m_slot->generation;
+    }
+}
+
+template <typename T>
+template <typename U, typename>
+Handle<T>::Handle(const Ptr<U>& ptr) :
+    Handle(static_cast<T*>(ptr.get()))
 {
 
 }
 
 template <typename T>
-Handle<T>::Handle(WkPtr<T> wkPtr) :
-    m_wkPtr(wkPtr)
+template <typename U, typename>
+Handle<T>::Handle(const WkPtr<U>& wkPtr) :
+    Handle(static_cast<T*>(wkPtr.lock().get()))
 {
 
 }
 
 template <typename T>
 template <typename U>
-Handle<T>::Handle(Handle<U> handle) {
-    *this = handle.template as<T>();
+Handle<T>::Handle(Handle<U> handle) :
+    Handle()
+{
+    if constexpr (std::is_base_of<T, U>::value) {
+        m_ptr = handle.m_ptr;
+        m_slot = handle.m_slot;
+        m_generation = handle.m_generation;
+    }
+    else {
+        *this = handle.template as<T>();
+    }
 }
 
 template <typename T>
 template <typename U>
-Handle<U> Handle<T>::as() {
-    Ptr<U> ptr = std::dynamic_pointer_cast<U>(m_wkPtr.lock());
-    return Handle<U>(ptr);
+Handle<U> Handle<T>::as() const {
+    Handle<U> handle;
+    if (isValid()) {
+        handle.m_ptr = HandleCast<U, T>::cast(m_ptr);
+        if (handle.m_ptr) {
+            handle.m_slot = m_slot;
+            handle.m_generation = m_generation;
+        }
+    }
+    return handle;
 }
 
 template <typename T>
 T* Handle<T>::operator->() const {
     assert(isValid());
-    return m_wkPtr.lock().get();
+    return m_ptr;
 }
 
 template <typename T>
@@ -122,17 +268,23 @@ Handle<T>::operator bool() const {
 
 template <typename T>
 bool Handle<T>::isValid() const {
-    return !m_wkPtr.expired() && get() != nullptr;
+    return m_slot != nullptr && m_slot->generation == m_generation;
 }
 
 template <typename T>
 T* Handle<T>::get() const {
-    return m_wkPtr.lock().get();
+    return isValid() ? m_ptr : nullptr;
 }
 
 template <typename T>
 Ptr<T> Handle<T>::lock() const {
-    return m_wkPtr.lock();
+    if (!isValid())
+        return Ptr<T>();
+    const Tracked* tracked = m_ptr;
+    Ptr<const Tracked> owner = tracked->weak_from_this().lock();
+    if (!owner)
+        return Ptr<T>();
+    return Ptr<T>(owner, m_ptr);
 }
 
 template <typename T>
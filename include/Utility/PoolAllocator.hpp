@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <typeinfo>
+
+namespace carnot {
+
+//==============================================================================
+// MEMORY POOL
+//==============================================================================
+
+/// Occupancy statistics of a MemoryPool
+struct PoolStats {
+    std::string name;        ///< name of the pool (usually the pooled type)
+    std::size_t blockSize;   ///< size of each block in bytes
+    std::size_t capacity;    ///< number of blocks reserved
+    std::size_t used;        ///< number of blocks in use
+    std::size_t peak;        ///< maximum number of blocks ever in use
+    std::size_t chunks;      ///< number of chunks allocated from the system
+    float fragmentation;     ///< fraction of reserved blocks that are free
+};
+
+/// Fixed block size allocator. Blocks are carved from geometrically growing
+/// chunks and recycled through a free list, so objects of the same type are
+/// packed together and allocation never touches the system heap once the
+/// pool is warm. Chunks are kept for the lifetime of the pool. Not
+/// thread-safe.
+class MemoryPool {
+public:
+
+    /// Constructs an empty pool (the block size is set on first allocation)
+    MemoryPool(const std::string& name);
+    /// Destructor (releases all chunks)
+    ~MemoryPool();
+
+    /// Allocates a block of at least size bytes
+    void* allocate(std::size_t size, std::size_t alignment);
+    /// Returns a block to the pool
+    void deallocate(void* block);
+
+    /// Gets the occupancy statistics of this pool
+    PoolStats getStats() const;
+
+    /// Gets the occupancy statistics of all pools
+    static std::vector<PoolStats> getAllStats();
+
+private:
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    /// Reserves a new chunk and pushes its blocks onto the free list
+    void grow();
+
+    std::string m_name;              ///< pool name
+    std::size_t m_blockSize;         ///< block size in bytes
+    std::size_t m_alignment;         ///< block alignment in bytes
+    std::vector<void*> m_chunks;     ///< chunks reserved from the system
+    std::size_t m_capacity;          ///< total number of blocks
+    std::size_t m_used;              ///< number of blocks in use
+    std::size_t m_peak;              ///< peak number of blocks in use
+    void* m_free;                    ///< head of the intrusive free list
+};
+
+namespace detail {
+
+/// Returns the pool used to allocate objects of type T (never destroyed, so
+/// objects may outlive static destruction)
+template <typename T>
+MemoryPool& poolFor();
+
+} // namespace detail
+
+//==============================================================================
+// POOL ALLOCATOR
+//==============================================================================
+
+/// Standard allocator which serves single object allocations from a
+/// MemoryPool. Intended for std::allocate_shared, which rebinds the
+/// allocator to its combined control block and object type.
+template <typename T>
+class PoolAllocator {
+public:
+
+    typedef T value_type;
+
+    /// Constructs an allocator drawing from the pool for T
+    PoolAllocator();
+    /// Rebinding constructor
+    template <typename U> PoolAllocator(const PoolAllocator<U>& other);
+
+    /// Allocates storage for n T's
+    T* allocate(std::size_t n);
+    /// Deallocates storage for n T's
+    void deallocate(T* p, std::size_t n);
+    /// Gets the pool serving single object allocations
+    MemoryPool* getPool() const;
+
+    template <typename U> friend class PoolAllocator;
+
+private:
+
+    MemoryPool* m_pool; ///< pool serving single object allocations
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs);
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs);
+
+//==============================================================================
+// Template / Inline Function Implementations
+//==============================================================================
+
+namespace detail {
+
+template <typename T>
+MemoryPool& poolFor() {
+    static MemoryPool* s_pool = new MemoryPool(typeid(T).name());
+    return *s_pool;
+}
+
+} // namespace detail
+
+template <typename T>
+PoolAllocator<T>::PoolAllocator() :
+    m_pool(&detail::poolFor<T>())
+{ }
+
+template <typename T>
+template <typename U>
+PoolAllocator<T>::PoolAllocator(const PoolAllocator<U>& other) :
+    m_pool(other.m_pool)
+{ }
+
+template <typename T>
+T* PoolAllocator<T>::allocate(std::size_t n) {
+    if (n == 1)
+        return static_cast<T*>(m_pool->allocate(sizeof(T), alignof(T)));
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+template <typename T>
+void PoolAllocator<T>::deallocate(T* p, std::size_t n) {
+    if (n == 1)
+        m_pool->deallocate(p);
+    else
+        ::operator delete(p);
+}
+
+template <typename T>
+MemoryPool* PoolAllocator<T>::getPool() const {
+    return m_pool;
+}
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+    return lhs.getPool() == rhs.getPool();
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+} // namespace carnot
@@ -5,6 +5,7 @@
 #include <list>
 #include <vector>
 #include <algorithm>
+#include <Utility/DeferQueue.hpp>
 
 namespace carnot
 {
@@ -147,6 +148,12 @@ public:
     emit(Args... args) const
     {
         Collector collector;
+        // inside a parallel section, emit at its merge point instead
+        if (auto queue = detail::deferQueue())
+        {
+            queue->push_back([this, args...]() { this->emit(args...); });
+            return collector.result();
+        }
         for (auto &slot : callback_list_)
         {
             if (slot)
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+
+namespace carnot {
+
+/// Small dense integer identifying a C++ type at runtime without RTTI
+typedef std::size_t TypeId;
+
+/// TypeId of unknown types
+constexpr TypeId InvalidTypeId = static_cast<TypeId>(-1);
+
+namespace detail {
+/// Returns the next unused TypeId
+inline TypeId nextTypeId() {
+    static std::atomic<TypeId> s_next(0);
+    return s_next++;
+}
+} // namespace detail
+
+/// Returns the TypeId of T. Ids are assigned densely, starting at zero, on
+/// first use and are stable for the lifetime of the program.
+template <typename T>
+TypeId typeId() {
+    static const TypeId s_id = detail::nextTypeId();
+    return s_id;
+}
+
+} // namespace carnot
@@ -17,6 +17,85 @@
 */
 
 #include <Box2D/Collision/b2BroadPhase.h>
+#include <new>
+
+// Gathers the pairs of the moved proxies queried on one thread.
+struct b2PairQuery
+{
+	b2PairQuery()
+	{
+		pairCapacity = 16;
+		pairCount = 0;
+		pairs = (b2Pair*)b2Alloc(pairCapacity * sizeof(b2Pair));
+	}
+
+	~b2PairQuery()
+	{
+		b2Free(pairs);
+	}
+
+	// This is called from b2DynamicTree::Query, see b2BroadPhase::QueryCallback.
+	bool QueryCallback(int32 proxyId)
+	{
+		// A proxy cannot form a pair with itself.
+		if (proxyId == queryProxyId)
+		{
+			return true;
+		}
+
+		// Grow the pair buffer as needed.
+		if (pairCount == pairCapacity)
+		{
+			b2Pair* oldBuffer = pairs;
+			pairCapacity *= 2;
+			pairs = (b2Pair*)b2Alloc(pairCapacity * sizeof(b2Pair));
+			memcpy(pairs, oldBuffer, pairCount * sizeof(b2Pair));
+			b2Free(oldBuffer);
+		}
+
+		pairs[pairCount].proxyIdA = b2Min(proxyId, queryProxyId);
+		pairs[pairCount].proxyIdB = b2Max(proxyId, queryProxyId);
+		++pairCount;
+
+		return true;
+	}
+
+	int32 queryProxyId;
+	b2Pair* pairs;
+	int32 pairCapacity;
+	int32 pairCount;
+};
+
+namespace
+{
+
+// Queries the tree for a range of the move buffer.
+class b2QueryMovesTask : public b2ParallelTask
+{
+public:
+	void Execute(int32 begin, int32 end, int32 threadIndex)
+	{
+		b2PairQuery* query = queries + threadIndex;
+		for (int32 i = begin; i < end; ++i)
+		{
+			query->queryProxyId = moveBuffer[i];
+			if (query->queryProxyId == b2BroadPhase::e_nullProxy)
+			{
+				continue;
+			}
+
+			// We have to query the tree with the fat AABB so that
+			// we don't fail to create a pair that may touch later.
+			tree->Query(query, tree->GetFatAABB(query->queryProxyId));
+		}
+	}
+
+	const b2DynamicTree* tree;
+	const int32* moveBuffer;
+	b2PairQuery* queries;
+};
+
+} // namespace
 
 b2BroadPhase::b2BroadPhase()
 {
@@ -29,10 +108,18 @@ b2BroadPhase::b2BroadPhase()
 	m_moveCapacity = 16;
 	m_moveCount = 0;
 	m_moveBuffer = (int32*)b2Alloc(m_moveCapacity * sizeof(int32));
+
+	m_threadQueries = NULL;
+	m_threadQueryCount = 0;
 }
 
 b2BroadPhase::~b2BroadPhase()
 {
+	for (int32 i = 0; i < m_threadQueryCount; ++i)
+	{
+		m_threadQueries[i].~b2PairQuery();
+	}
+	b2Free(m_threadQueries);
 	b2Free(m_moveBuffer);
 	b2Free(m_pairBuffer);
 }
@@ -117,3 +204,57 @@ bool b2BroadPhase::QueryCallback(int32 proxyId)
 
 	return true;
 }
+
+void b2BroadPhase::QueryMovesParallel(b2TaskExecutor* executor)
+{
+	int32 threadCount = executor->GetThreadCount();
+	if (m_threadQueryCount < threadCount)
+	{
+		for (int32 i = 0; i < m_threadQueryCount; ++i)
+		{
+			m_threadQueries[i].~b2PairQuery();
+		}
+		b2Free(m_threadQueries);
+		m_threadQueries = (b2PairQuery*)b2Alloc(threadCount * sizeof(b2PairQuery));
+		for (int32 i = 0; i < threadCount; ++i)
+		{
+			new (m_threadQueries + i) b2PairQuery();
+		}
+		m_threadQueryCount = threadCount;
+	}
+
+	for (int32 i = 0; i < threadCount; ++i)
+	{
+		m_threadQueries[i].pairCount = 0;
+	}
+
+	b2QueryMovesTask task;
+	task.tree = &m_tree;
+	task.moveBuffer = m_moveBuffer;
+	task.queries = m_threadQueries;
+	executor->ParallelFor(m_moveCount, 32, &task);
+
+	// Gather the pairs. The order does not matter since they are sorted.
+	int32 pairCount = 0;
+	for (int32 i = 0; i < threadCount; ++i)
+	{
+		pairCount += m_threadQueries[i].pairCount;
+	}
+
+	if (m_pairCapacity < pairCount)
+	{
+		b2Free(m_pairBuffer);
+		while (m_pairCapacity < pairCount)
+		{
+			m_pairCapacity *= 2;
+		}
+		m_pairBuffer = (b2Pair*)b2Alloc(m_pairCapacity * sizeof(b2Pair));
+	}
+
+	for (int32 i = 0; i < threadCount; ++i)
+	{
+		const b2PairQuery& query = m_threadQueries[i];
+		memcpy(m_pairBuffer + m_pairCount, query.pairs, query.pairCount * sizeof(b2Pair));
+		m_pairCount += query.pairCount;
+	}
+}
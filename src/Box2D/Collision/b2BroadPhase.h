@@ -22,6 +22,7 @@
 #include <Box2D/Common/b2Settings.h>
 #include <Box2D/Collision/b2Collision.h>
 #include <Box2D/Collision/b2DynamicTree.h>
+#include <Box2D/Common/b2TaskExecutor.h>
 #include <algorithm>
 
 struct b2Pair
@@ -30,6 +31,8 @@ struct b2Pair
 	int32 proxyIdB;
 };
 
+struct b2PairQuery;
+
 /// The broad-phase is used for computing pairs and performing volume queries and ray casts.
 /// This broad-phase does not persist pairs. Instead, this reports potentially new pairs.
 /// It is up to the client to consume the new pairs and to track subsequent overlap.
@@ -72,8 +75,10 @@ public:
 	int32 GetProxyCount() const;
 
 	/// Update the pairs. This results in pair callbacks. This can only add pairs.
+	/// If an executor is given the tree queries are spread over its threads.
+	/// The pair callbacks are still made on the calling thread in the same order.
 	template <typename T>
-	void UpdatePairs(T* callback);
+	void UpdatePairs(T* callback, b2TaskExecutor* executor = NULL);
 
 	/// Query an AABB for overlapping proxies. The callback class
 	/// is called for each proxy that overlaps the supplied AABB.
@@ -113,6 +118,10 @@ private:
 
 	bool QueryCallback(int32 proxyId);
 
+	// Fill the pair buffer by querying the tree for all moved proxies on the
+	// executor. The pairs are unsorted.
+	void QueryMovesParallel(b2TaskExecutor* executor);
+
 	b2DynamicTree m_tree;
 
 	int32 m_proxyCount;
@@ -126,6 +135,10 @@ private:
 	int32 m_pairCount;
 
 	int32 m_queryProxyId;
+
+	// Per thread pair buffers for QueryMovesParallel.
+	b2PairQuery* m_threadQueries;
+	int32 m_threadQueryCount;
 };
 
 /// This is used to sort pairs.
@@ -182,26 +195,33 @@ inline float32 b2BroadPhase::GetTreeQuality() const
 }
 
 template <typename T>
-void b2BroadPhase::UpdatePairs(T* callback)
+void b2BroadPhase::UpdatePairs(T* callback, b2TaskExecutor* executor)
 {
 	// Reset pair buffer
 	m_pairCount = 0;
 
-	// Perform tree queries for all moving proxies.
-	for (int32 i = 0; i < m_moveCount; ++i)
+	if (executor != NULL && executor->GetThreadCount() > 1)
+	{
+		QueryMovesParallel(executor);
+	}
+	else
 	{
-		m_queryProxyId = m_moveBuffer[i];
-		if (m_queryProxyId == e_nullProxy)
+		// Perform tree queries for all moving proxies.
+		for (int32 i = 0; i < m_moveCount; ++i)
 		{
-			continue;
-		}
+			m_queryProxyId = m_moveBuffer[i];
+			if (m_queryProxyId == e_nullProxy)
+			{
+				continue;
+			}
 
-		// We have to query the tree with the fat AABB so that
-		// we don't fail to create a pair that may touch later.
-		const b2AABB& fatAABB = m_tree.GetFatAABB(m_queryProxyId);
+			// We have to query the tree with the fat AABB so that
+			// we don't fail to create a pair that may touch later.
+			const b2AABB& fatAABB = m_tree.GetFatAABB(m_queryProxyId);
 
-		// Query tree, create pairs and add them pair buffer.
-		m_tree.Query(this, fatAABB);
+			// Query tree, create pairs and add them pair buffer.
+			m_tree.Query(this, fatAABB);
+		}
 	}
 
 	// Reset move buffer
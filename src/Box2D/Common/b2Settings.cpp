@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <atomic>
 
 b2Version b2_version = {2, 3, 0};
 
@@ -44,7 +45,8 @@ const char *b2_liquidFunVersionString =
 	LIQUIDFUN_STRING(LIQUIDFUN_VERSION_MINOR) "."
 	LIQUIDFUN_STRING(LIQUIDFUN_VERSION_REVISION);
 
-static int32 b2_numAllocs = 0;
+// Atomic since worlds with a b2TaskExecutor allocate from several threads.
+static std::atomic<int32> b2_numAllocs(0);
 
 // Initialize default allocator.
 static b2AllocFunction b2_allocCallback = b2AllocDefault;
@@ -0,0 +1,52 @@
+/*
+* Copyright (c) 2006-2009 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_TASK_EXECUTOR_H
+#define B2_TASK_EXECUTOR_H
+
+#include <Box2D/Common/b2Settings.h>
+
+/// A range of independent work items which may be split across threads.
+class b2ParallelTask
+{
+public:
+	virtual ~b2ParallelTask() {}
+
+	/// Process items [begin, end). threadIndex identifies the calling thread
+	/// and is less than b2TaskExecutor::GetThreadCount(). A thread runs at
+	/// most one call at a time.
+	virtual void Execute(int32 begin, int32 end, int32 threadIndex) = 0;
+};
+
+/// Implement this to let a b2World spread work over your own threads.
+/// The executor is owned by you and must remain in scope.
+class b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// Get the number of threads which may execute tasks, including the
+	/// calling thread.
+	virtual int32 GetThreadCount() const = 0;
+
+	/// Split [0, count) into chunks of at least minChunk items, call
+	/// task->Execute on each, and return once all chunks have finished.
+	virtual void ParallelFor(int32 count, int32 minChunk, b2ParallelTask* task) = 0;
+};
+
+#endif
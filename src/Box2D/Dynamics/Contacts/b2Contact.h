@@ -173,6 +173,22 @@ protected:
 		e_toiFlag			= 0x0020
 	};
 
+	// Events returned by UpdateManifold
+	enum
+	{
+		// The touching state changed, wake both bodies.
+		e_wakeEvent			= 0x0001,
+
+		// Report BeginContact.
+		e_beginEvent		= 0x0002,
+
+		// Report EndContact.
+		e_endEvent			= 0x0004,
+
+		// Report PreSolve.
+		e_preSolveEvent		= 0x0008
+	};
+
 	/// Flag this contact for filtering. Filtering will occur the next time step.
 	void FlagForFiltering();
 
@@ -189,6 +205,12 @@ protected:
 
 	void Update(b2ContactListener* listener);
 
+	// The two halves of Update. UpdateManifold only writes to this contact,
+	// so different contacts may be updated concurrently. It returns the
+	// events which ReportUpdate then applies to the bodies and listener.
+	uint32 UpdateManifold(b2Manifold* oldManifold);
+	void ReportUpdate(uint32 events, const b2Manifold* oldManifold, b2ContactListener* listener);
+
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
 
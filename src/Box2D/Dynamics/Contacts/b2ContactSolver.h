@@ -64,6 +64,7 @@ struct b2ContactSolverDef
 	b2Position* positions;
 	b2Velocity* velocities;
 	b2StackAllocator* allocator;
+	const int32* staticIndices;	///< island indices of static bodies, see b2Body::GetIslandIndex
 };
 
 class b2ContactSolver
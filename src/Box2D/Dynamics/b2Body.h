@@ -448,6 +448,11 @@ private:
 
 	void Advance(float32 t);
 
+	// Index of the body in the island being solved. Static bodies may be
+	// shared by islands solved in parallel, so when a table is given their
+	// m_islandIndex is a slot in it holding the index for this island.
+	int32 GetIslandIndex(const int32* staticIndices) const;
+
 	b2BodyType m_type;
 
 	uint16 m_flags;
@@ -874,6 +879,15 @@ inline b2World* b2Body::GetWorld()
 	return m_world;
 }
 
+inline int32 b2Body::GetIslandIndex(const int32* staticIndices) const
+{
+	if (staticIndices != NULL && m_type == b2_staticBody)
+	{
+		return staticIndices[m_islandIndex];
+	}
+	return m_islandIndex;
+}
+
 inline const b2World* b2Body::GetWorld() const
 {
 	return m_world;
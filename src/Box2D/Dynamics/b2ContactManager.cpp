@@ -22,6 +22,21 @@
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
+#include <Box2D/Common/b2TaskExecutor.h>
+
+// A contact gathered by b2ContactManager::CollideParallel.
+struct b2ContactUpdate
+{
+	enum
+	{
+		e_destroy = 0x80000000
+	};
+
+	b2Contact* contact;
+	// e_destroy, or the events returned by b2Contact::UpdateManifold.
+	uint32 events;
+	b2Manifold oldManifold;
+};
 
 b2ContactFilter b2_defaultFilter;
 b2ContactListener b2_defaultListener;
@@ -33,6 +48,14 @@ b2ContactManager::b2ContactManager()
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = NULL;
+	m_taskExecutor = NULL;
+	m_updateBuffer = NULL;
+	m_updateCapacity = 0;
+}
+
+b2ContactManager::~b2ContactManager()
+{
+	b2Free(m_updateBuffer);
 }
 
 void b2ContactManager::Destroy(b2Contact* c)
@@ -105,6 +128,12 @@ void b2ContactManager::Destroy(b2Contact* c)
 // contact list.
 void b2ContactManager::Collide()
 {
+	if (m_taskExecutor != NULL)
+	{
+		CollideParallel();
+		return;
+	}
+
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
@@ -170,9 +199,121 @@ void b2ContactManager::Collide()
 	}
 }
 
+namespace
+{
+
+// Updates the manifolds of a range of gathered contacts.
+class b2UpdateManifoldsTask : public b2ParallelTask
+{
+public:
+	void Execute(int32 begin, int32 end, int32 threadIndex)
+	{
+		B2_NOT_USED(threadIndex);
+		b2ContactManager::UpdateManifolds(updates, begin, end);
+	}
+
+	b2ContactUpdate* updates;
+};
+
+} // namespace
+
+void b2ContactManager::UpdateManifolds(b2ContactUpdate* updates, int32 begin, int32 end)
+{
+	for (int32 i = begin; i < end; ++i)
+	{
+		b2ContactUpdate* update = updates + i;
+		if (update->events != b2ContactUpdate::e_destroy)
+		{
+			update->events = update->contact->UpdateManifold(&update->oldManifold);
+		}
+	}
+}
+
+// Collide in three passes so that the result does not depend on the number
+// of threads. The first pass filters contacts in list order exactly like
+// Collide, the second updates the manifolds concurrently, and the third
+// destroys contacts and reports wake ups and listener events in list order.
+// Unlike Collide, a body woken by a contact does not make the later contacts
+// of a sleeping body active until the next step.
+void b2ContactManager::CollideParallel()
+{
+	if (m_updateCapacity < m_contactCount)
+	{
+		b2Free(m_updateBuffer);
+		m_updateCapacity = b2Max(2 * m_updateCapacity, m_contactCount);
+		m_updateBuffer = (b2ContactUpdate*)b2Alloc(m_updateCapacity * sizeof(b2ContactUpdate));
+	}
+
+	int32 updateCount = 0;
+	for (b2Contact* c = m_contactList; c; c = c->GetNext())
+	{
+		b2Fixture* fixtureA = c->GetFixtureA();
+		b2Fixture* fixtureB = c->GetFixtureB();
+		int32 indexA = c->GetChildIndexA();
+		int32 indexB = c->GetChildIndexB();
+		b2Body* bodyA = fixtureA->GetBody();
+		b2Body* bodyB = fixtureB->GetBody();
+		b2ContactUpdate* update = m_updateBuffer + updateCount;
+		update->contact = c;
+		update->events = 0;
+
+		// Is this contact flagged for filtering?
+		if (c->m_flags & b2Contact::e_filterFlag)
+		{
+			// Should these bodies collide? Check user filtering.
+			if (bodyB->ShouldCollide(bodyA) == false ||
+				(m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false))
+			{
+				update->events = b2ContactUpdate::e_destroy;
+				++updateCount;
+				continue;
+			}
+
+			// Clear the filtering flag.
+			c->m_flags &= ~b2Contact::e_filterFlag;
+		}
+
+		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+
+		// At least one body must be awake and it must be dynamic or kinematic.
+		if (activeA == false && activeB == false)
+		{
+			continue;
+		}
+
+		int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
+		int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
+
+		// Here we destroy contacts that cease to overlap in the broad-phase.
+		if (m_broadPhase.TestOverlap(proxyIdA, proxyIdB) == false)
+		{
+			update->events = b2ContactUpdate::e_destroy;
+		}
+		++updateCount;
+	}
+
+	b2UpdateManifoldsTask task;
+	task.updates = m_updateBuffer;
+	m_taskExecutor->ParallelFor(updateCount, 64, &task);
+
+	for (int32 i = 0; i < updateCount; ++i)
+	{
+		b2ContactUpdate* update = m_updateBuffer + i;
+		if (update->events == b2ContactUpdate::e_destroy)
+		{
+			Destroy(update->contact);
+		}
+		else
+		{
+			update->contact->ReportUpdate(update->events, &update->oldManifold, m_contactListener);
+		}
+	}
+}
+
 void b2ContactManager::FindNewContacts()
 {
-	m_broadPhase.UpdatePairs(this);
+	m_broadPhase.UpdatePairs(this, m_taskExecutor);
 }
 
 void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
@@ -22,6 +22,8 @@
 #include <Box2D/Collision/b2BroadPhase.h>
 
 class b2Contact;
+struct b2ContactUpdate;
+class b2TaskExecutor;
 class b2ContactFilter;
 class b2ContactListener;
 class b2BlockAllocator;
@@ -34,6 +36,7 @@ public:
 	friend class b2ParticleSystem;
 
 	b2ContactManager();
+	~b2ContactManager();
 
 	// Broad-phase callback.
 	void AddPair(void* proxyUserDataA, void* proxyUserDataB);
@@ -43,13 +46,24 @@ public:
 	void Destroy(b2Contact* c);
 
 	void Collide();
-            
+
+	// Collide with the narrow-phase spread over m_taskExecutor. Contacts are
+	// destroyed and events are reported on the calling thread in list order.
+	void CollideParallel();
+
+	// Update the manifolds of the gathered contacts [begin, end).
+	static void UpdateManifolds(b2ContactUpdate* updates, int32 begin, int32 end);
+
 	b2BroadPhase m_broadPhase;
 	b2Contact* m_contactList;
 	int32 m_contactCount;
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
+	b2TaskExecutor* m_taskExecutor;
+
+	b2ContactUpdate* m_updateBuffer;
+	int32 m_updateCapacity;
 };
 
 #endif
@@ -52,7 +52,14 @@ public:
 	void Add(b2Body* body)
 	{
 		b2Assert(m_bodyCount < m_bodyCapacity);
-		body->m_islandIndex = m_bodyCount;
+		if (m_staticIndices != NULL && body->m_type == b2_staticBody)
+		{
+			m_staticIndices[body->m_islandIndex] = m_bodyCount;
+		}
+		else
+		{
+			body->m_islandIndex = m_bodyCount;
+		}
 		m_bodies[m_bodyCount] = body;
 		++m_bodyCount;
 	}
@@ -74,6 +81,11 @@ public:
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
+	// Per thread island indices of static bodies when islands are solved in
+	// parallel (see b2Body::GetIslandIndex), otherwise NULL. Static bodies
+	// are then left untouched since other islands may be reading them.
+	int32* m_staticIndices;
+
 	b2Body** m_bodies;
 	b2Contact** m_contacts;
 	b2Joint** m_joints;
@@ -67,6 +67,7 @@ struct b2SolverData
 	b2TimeStep step;
 	b2Position* positions;
 	b2Velocity* velocities;
+	const int32* staticIndices;	///< island indices of static bodies, see b2Body::GetIslandIndex
 };
 
 #endif
@@ -65,6 +65,12 @@ b2World::~b2World()
 		DestroyParticleSystem(m_particleSystemList);
 	}
 
+	for (int32 i = 0; i < m_threadAllocatorCount; ++i)
+	{
+		m_threadAllocators[i].~b2StackAllocator();
+	}
+	b2Free(m_threadAllocators);
+
 	// Even though the block allocator frees them for us, for safety,
 	// we should ensure that all buffers have been freed.
 	b2Assert(m_blockAllocator.GetNumGiantAllocations() == 0);
@@ -85,6 +91,12 @@ void b2World::SetContactListener(b2ContactListener* listener)
 	m_contactManager.m_contactListener = listener;
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	m_taskExecutor = executor;
+	m_contactManager.m_taskExecutor = executor;
+}
+
 void b2World::SetDebugDraw(b2Draw* debugDraw)
 {
 	m_debugDraw = debugDraw;
@@ -426,6 +438,10 @@ void b2World::Init(const b2Vec2& gravity)
 	m_destructionListener = NULL;
 	m_debugDraw = NULL;
 
+	m_taskExecutor = NULL;
+	m_threadAllocators = NULL;
+	m_threadAllocatorCount = 0;
+
 	m_bodyList = NULL;
 	m_jointList = NULL;
 	m_particleSystemList = NULL;
@@ -467,13 +483,6 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
-	// Size the island for the worst case.
-	b2Island island(m_bodyCount,
-					m_contactManager.m_contactCount,
-					m_jointCount,
-					&m_stackAllocator,
-					m_contactManager.m_contactListener);
-
 	// Clear all the island flags.
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
@@ -488,6 +497,51 @@ void b2World::Solve(const b2TimeStep& step)
 		j->m_islandFlag = false;
 	}
 
+	if (m_taskExecutor != NULL && m_taskExecutor->GetThreadCount() > 1)
+	{
+		SolveIslandsParallel(step);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		{
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
+		}
+
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+// Build and solve islands one after another on the calling thread.
+void b2World::SolveIslands(const b2TimeStep& step)
+{
+	// Size the island for the worst case.
+	b2Island island(m_bodyCount,
+					m_contactManager.m_contactCount,
+					m_jointCount,
+					&m_stackAllocator,
+					m_contactManager.m_contactListener);
+
 	// Build and simulate all awake islands.
 	int32 stackSize = m_bodyCount;
 	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
@@ -624,31 +678,304 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 
 	m_stackAllocator.Free(stack);
+}
 
-	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+namespace
+{
+
+// Bodies, contacts and joints of one island within the flat arrays built by
+// b2World::SolveIslandsParallel.
+struct b2IslandRange
+{
+	int32 bodyStart, bodyCount;
+	int32 contactStart, contactCount;
+	int32 jointStart, jointCount;
+};
+
+// Solves a range of islands on one executor thread.
+class b2SolveIslandsTask : public b2ParallelTask
+{
+public:
+	void Execute(int32 begin, int32 end, int32 threadIndex)
+	{
+		b2StackAllocator* allocator = allocators + threadIndex;
+		int32 tableSize = b2Max(staticCount, 1) * sizeof(int32);
+		int32* staticIndices = (int32*)allocator->Allocate(tableSize);
+		// Zeroed so joints referencing static bodies outside of the island
+		// (e.g. gear joints) still read a valid index.
+		memset(staticIndices, 0, tableSize);
+		b2Profile* total = profiles + threadIndex;
+		for (int32 i = begin; i < end; ++i)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			const b2IslandRange& range = islands[i];
+			b2Island island(range.bodyCount, range.contactCount, range.jointCount, allocator, NULL);
+			island.m_staticIndices = staticIndices;
+			for (int32 j = 0; j < range.bodyCount; ++j)
 			{
-				continue;
+				island.Add(bodies[range.bodyStart + j]);
 			}
+			for (int32 j = 0; j < range.contactCount; ++j)
+			{
+				island.Add(contacts[range.contactStart + j]);
+			}
+			for (int32 j = 0; j < range.jointCount; ++j)
+			{
+				island.Add(joints[range.jointStart + j]);
+			}
+
+			b2Profile profile;
+			island.Solve(&profile, *step, gravity, allowSleep);
+			total->solveInit += profile.solveInit;
+			total->solveVelocity += profile.solveVelocity;
+			total->solvePosition += profile.solvePosition;
+		}
+		allocator->Free(staticIndices);
+	}
+
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+	const b2IslandRange* islands;
+	b2Body** bodies;
+	b2Contact** contacts;
+	b2Joint** joints;
+	int32 staticCount;
+	b2StackAllocator* allocators;
+	b2Profile* profiles;
+};
+
+} // namespace
+
+// Build all islands on the calling thread, then solve them concurrently on
+// the task executor. Each island only writes its own dynamic and kinematic
+// bodies, contacts and joints. Static bodies may be shared between islands,
+// so they are left untouched and each thread keeps their island indices in
+// its own table.
+void b2World::SolveIslandsParallel(const b2TimeStep& step)
+{
+	int32 threadCount = m_taskExecutor->GetThreadCount();
+	if (m_threadAllocatorCount < threadCount)
+	{
+		for (int32 i = 0; i < m_threadAllocatorCount; ++i)
+		{
+			m_threadAllocators[i].~b2StackAllocator();
+		}
+		b2Free(m_threadAllocators);
+		m_threadAllocators = (b2StackAllocator*)b2Alloc(threadCount * sizeof(b2StackAllocator));
+		for (int32 i = 0; i < threadCount; ++i)
+		{
+			new (m_threadAllocators + i) b2StackAllocator();
+		}
+		m_threadAllocatorCount = threadCount;
+	}
+
+	// Number the static bodies; this is their slot in the per thread tables.
+	int32 staticCount = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		if (b->GetType() == b2_staticBody)
+		{
+			b->m_islandIndex = staticCount++;
+		}
+	}
+
+	// A static body is repeated in every island it touches, once per contact
+	// or joint at most.
+	int32 contactCapacity = m_contactManager.m_contactCount;
+	int32 bodyCapacity = m_bodyCount + contactCapacity + m_jointCount;
+	b2Body** bodies = (b2Body**)m_stackAllocator.Allocate(bodyCapacity * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)m_stackAllocator.Allocate(contactCapacity * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+	b2IslandRange* islands = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	int32 bodyTotal = 0;
+	int32 contactTotal = 0;
+	int32 jointTotal = 0;
+	int32 islandCount = 0;
+
+	// Build all awake islands, in the same order as SolveIslands.
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange* range = islands + islandCount++;
+		range->bodyStart = bodyTotal;
+		range->contactStart = contactTotal;
+		range->jointStart = jointTotal;
+
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		// Perform a depth first search (DFS) on the constraint graph.
+		while (stackCount > 0)
+		{
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsActive() == true);
+			b2Assert(bodyTotal < bodyCapacity);
+			bodies[bodyTotal++] = b;
 
+			// Make sure the body is awake.
+			b->SetAwake(true);
+
+			// To keep islands as small as possible, we don't
+			// propagate islands across static bodies.
 			if (b->GetType() == b2_staticBody)
 			{
 				continue;
 			}
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+			// Search all contacts connected to this body.
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+
+				// Has this contact already been added to an island?
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				// Is this contact solid and touching?
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				// Skip sensors.
+				bool sensorA = contact->m_fixtureA->m_isSensor;
+				bool sensorB = contact->m_fixtureB->m_isSensor;
+				if (sensorA || sensorB)
+				{
+					continue;
+				}
+
+				contacts[contactTotal++] = contact;
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+
+				// Was the other body already added to this island?
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+
+			// Search all joints connect to this body.
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				// Don't simulate joints connected to inactive bodies.
+				if (other->IsActive() == false)
+				{
+					continue;
+				}
+
+				joints[jointTotal++] = je->joint;
+				je->joint->m_islandFlag = true;
+
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		range->bodyCount = bodyTotal - range->bodyStart;
+		range->contactCount = contactTotal - range->contactStart;
+		range->jointCount = jointTotal - range->jointStart;
+
+		// Allow static bodies to participate in other islands.
+		for (int32 i = range->bodyStart; i < bodyTotal; ++i)
+		{
+			if (bodies[i]->GetType() == b2_staticBody)
+			{
+				bodies[i]->m_flags &= ~b2Body::e_islandFlag;
+			}
+		}
 	}
+	m_stackAllocator.Free(stack);
+
+	// Solve the islands concurrently.
+	b2Profile* profiles = (b2Profile*)m_stackAllocator.Allocate(threadCount * sizeof(b2Profile));
+	memset(profiles, 0, threadCount * sizeof(b2Profile));
+	b2SolveIslandsTask task;
+	task.step = &step;
+	task.gravity = m_gravity;
+	task.allowSleep = m_allowSleep;
+	task.islands = islands;
+	task.bodies = bodies;
+	task.contacts = contacts;
+	task.joints = joints;
+	task.staticCount = staticCount;
+	task.allocators = m_threadAllocators;
+	task.profiles = profiles;
+	m_taskExecutor->ParallelFor(islandCount, 1, &task);
+	for (int32 i = 0; i < threadCount; ++i)
+	{
+		m_profile.solveInit += profiles[i].solveInit;
+		m_profile.solveVelocity += profiles[i].solveVelocity;
+		m_profile.solvePosition += profiles[i].solvePosition;
+	}
+	m_stackAllocator.Free(profiles);
+
+	// Report solver impulses in island order. They were stored in the
+	// manifolds for warm starting, so they can be read back from there.
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+	if (listener != NULL)
+	{
+		for (int32 i = 0; i < contactTotal; ++i)
+		{
+			b2Contact* contact = contacts[i];
+			const b2Manifold* manifold = contact->GetManifold();
+
+			b2ContactImpulse impulse;
+			impulse.count = manifold->pointCount;
+			for (int32 j = 0; j < manifold->pointCount; ++j)
+			{
+				impulse.normalImpulses[j] = manifold->points[j].normalImpulse;
+				impulse.tangentImpulses[j] = manifold->points[j].tangentImpulse;
+			}
+
+			listener->PostSolve(contact, &impulse);
+		}
+	}
+
+	m_stackAllocator.Free(islands);
+	m_stackAllocator.Free(joints);
+	m_stackAllocator.Free(contacts);
+	m_stackAllocator.Free(bodies);
 }
 
 // Find TOI contacts and solve them.
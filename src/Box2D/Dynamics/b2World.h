@@ -23,6 +23,7 @@
 #include <Box2D/Common/b2Math.h>
 #include <Box2D/Common/b2BlockAllocator.h>
 #include <Box2D/Common/b2StackAllocator.h>
+#include <Box2D/Common/b2TaskExecutor.h>
 #include <Box2D/Dynamics/b2ContactManager.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
@@ -69,6 +70,17 @@ public:
 	/// by you and must remain in scope.
 	void SetDebugDraw(b2Draw* debugDraw);
 
+	/// Register a task executor used to spread the narrow-phase, broad-phase
+	/// pair queries and independent islands over several threads. Contact
+	/// listener callbacks are still made on the calling thread in a stable
+	/// order, and the results do not depend on the number of threads. Pass
+	/// NULL to step on the calling thread only. The executor is owned by you
+	/// and must remain in scope.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
+	/// Get the registered task executor (NULL if none).
+	b2TaskExecutor* GetTaskExecutor() const;
+
 	/// Create a rigid body given a definition. No reference to the definition
 	/// is retained.
 	/// @warning This function is locked during callbacks.
@@ -301,6 +313,8 @@ private:
 	void Init(const b2Vec2& gravity);
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveIslandsParallel(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -328,6 +342,11 @@ private:
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
 
+	b2TaskExecutor* m_taskExecutor;
+	// One stack allocator per executor thread for parallel island solving.
+	b2StackAllocator* m_threadAllocators;
+	int32 m_threadAllocatorCount;
+
 	// This is used to compute the time step ratio to
 	// support a variable time step.
 	float32 m_inv_dt0;
@@ -347,6 +366,11 @@ private:
 	const char *m_liquidFunVersionString;
 };
 
+inline b2TaskExecutor* b2World::GetTaskExecutor() const
+{
+	return m_taskExecutor;
+}
+
 inline b2Body* b2World::GetBodyList()
 {
 	return m_bodyList;
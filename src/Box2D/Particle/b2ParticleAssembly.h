@@ -24,10 +24,17 @@
 
 struct b2ParticleContact;
 
+#if defined(LIQUIDFUN_SIMD_NEON)
+// b2ParticleAssembly.neon.s reads 16-bit indices.
+typedef uint16 FindContactIndex;
+#else
+typedef uint32 FindContactIndex;
+#endif
+
 struct FindContactCheck
 {
-    uint16 particleIndex;
-    uint16 comparatorIndex;
+    FindContactIndex particleIndex;
+    FindContactIndex comparatorIndex;
 };
 
 struct FindContactInput
@@ -60,4 +67,33 @@ extern void FindContactsFromChecks_Simd(
 } // extern "C"
 #endif
 
+/// x86 instruction sets used by the particle kernels in
+/// b2ParticleAssembly.x86.cpp. They are built when LIQUIDFUN_SIMD_X86 is
+/// defined and picked at runtime from what the CPU supports.
+enum b2ParticleSimdLevel
+{
+	b2_particleSimdNone,
+	b2_particleSimdSse2,
+	b2_particleSimdAvx2
+};
+
+/// Get the instruction set used by the particle kernels. This is the best one
+/// supported by the CPU, but no higher than the limit set with
+/// b2SetParticleSimdLevel. Always b2_particleSimdNone without LIQUIDFUN_SIMD_X86.
+b2ParticleSimdLevel b2GetParticleSimdLevel();
+
+/// Limit the instruction set used by the particle kernels, e.g. to compare
+/// them against the reference implementation. Defaults to b2_particleSimdAvx2.
+void b2SetParticleSimdLevel(b2ParticleSimdLevel maxLevel);
+
+#if defined(LIQUIDFUN_SIMD_X86)
+
+/// Same results as computeTag for every position.
+extern int CalculateTags_Simd(const b2Vec2* positions,
+                              int count,
+                              const float& inverseDiameter,
+                              uint32* outTags);
+
+#endif // defined(LIQUIDFUN_SIMD_X86)
+
 #endif
\ No newline at end of file
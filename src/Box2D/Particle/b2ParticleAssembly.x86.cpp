@@ -0,0 +1,191 @@
+/*
+* Copyright (c) 2014 Google, Inc.
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+#include <Box2D/Particle/b2ParticleAssembly.h>
+#include <Box2D/Particle/b2ParticleSystem.h>
+
+// x86 counterparts of CalculateTags in b2ParticleAssembly.neon.s. SSE2 is
+// always available on x86-64. The AVX2 kernel is compiled for that target
+// only and called when the CPU supports it. Both repeat the scalar arithmetic
+// operation for operation, so the results are bitwise identical to the
+// reference implementation.
+//
+// There is no x86 FindContactsFromChecks: finding contacts is dominated by
+// appending them, and SSE2/AVX2 kernels (reordering the positions, gathering
+// checks and comparing 4 or 8 at a time) measured slower than
+// FindContacts_Reference at every particle count from 1k to 200k.
+
+static b2ParticleSimdLevel s_maxSimdLevel = b2_particleSimdAvx2;
+
+void b2SetParticleSimdLevel(b2ParticleSimdLevel maxLevel)
+{
+	s_maxSimdLevel = maxLevel;
+}
+
+#if defined(LIQUIDFUN_SIMD_X86)
+
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define B2_TARGET_AVX2
+#else
+#define B2_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+static b2ParticleSimdLevel DetectSimdLevel()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] >= 7)
+	{
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		__cpuidex(info, 7, 0);
+		const bool avx2 = (info[1] & (1 << 5)) != 0;
+		// The OS must also save the ymm registers.
+		if (osxsave && avx && avx2 && (_xgetbv(0) & 6) == 6)
+		{
+			return b2_particleSimdAvx2;
+		}
+	}
+	return b2_particleSimdSse2;
+#else
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return b2_particleSimdAvx2;
+	}
+	return b2_particleSimdSse2;
+#endif
+}
+
+b2ParticleSimdLevel b2GetParticleSimdLevel()
+{
+	static const b2ParticleSimdLevel s_cpuLevel = DetectSimdLevel();
+	return b2Min(s_cpuLevel, s_maxSimdLevel);
+}
+
+// Must match the constants of computeTag in b2ParticleSystem.cpp.
+static const float32 xScale = 256.0f;
+static const float32 xOffset = 524288.0f;
+static const float32 yOffset = 2048.0f;
+static const int yShift = 20;
+
+// Converts through int32 like cvttps2dq does. This only differs from the
+// unsigned conversion in computeTag for positions far outside of the range
+// the tags can represent anyway.
+static inline uint32 CalculateTag(const b2Vec2& p, float32 inverseDiameter)
+{
+	const float32 x = inverseDiameter * p.x;
+	const float32 y = inverseDiameter * p.y;
+	return ((uint32)(int32)(y + yOffset) << yShift) +
+		   (uint32)(int32)(xScale * x + xOffset);
+}
+
+//==============================================================================
+// SSE2
+//==============================================================================
+
+static int CalculateTags_Sse2(const b2Vec2* positions, int count,
+							  float32 inverseDiameter, uint32* outTags)
+{
+	const __m128 invD = _mm_set1_ps(inverseDiameter);
+	const __m128 scale = _mm_set1_ps(xScale);
+	const __m128 offsetX = _mm_set1_ps(xOffset);
+	const __m128 offsetY = _mm_set1_ps(yOffset);
+	const float32* p = &positions[0].x;
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 p01 = _mm_loadu_ps(p + 2 * i);
+		const __m128 p23 = _mm_loadu_ps(p + 2 * i + 4);
+		const __m128 x = _mm_mul_ps(invD, _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0)));
+		const __m128 y = _mm_mul_ps(invD, _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1)));
+		const __m128i tagY = _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(y, offsetY)), yShift);
+		const __m128i tagX = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(scale, x), offsetX));
+		_mm_storeu_si128((__m128i*)(outTags + i), _mm_add_epi32(tagY, tagX));
+	}
+	for (; i < count; ++i)
+	{
+		outTags[i] = CalculateTag(positions[i], inverseDiameter);
+	}
+	return count;
+}
+
+//==============================================================================
+// AVX2
+//==============================================================================
+
+B2_TARGET_AVX2
+static int CalculateTags_Avx2(const b2Vec2* positions, int count,
+							  float32 inverseDiameter, uint32* outTags)
+{
+	const __m256 invD = _mm256_set1_ps(inverseDiameter);
+	const __m256 scale = _mm256_set1_ps(xScale);
+	const __m256 offsetX = _mm256_set1_ps(xOffset);
+	const __m256 offsetY = _mm256_set1_ps(yOffset);
+	const float32* p = &positions[0].x;
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		// Deinterleave within 128-bit lanes, so the tags come out in the
+		// order 0 1 4 5 2 3 6 7 and are permuted back before storing.
+		const __m256 p0123 = _mm256_loadu_ps(p + 2 * i);
+		const __m256 p4567 = _mm256_loadu_ps(p + 2 * i + 8);
+		const __m256 x = _mm256_mul_ps(invD, _mm256_shuffle_ps(p0123, p4567, _MM_SHUFFLE(2, 0, 2, 0)));
+		const __m256 y = _mm256_mul_ps(invD, _mm256_shuffle_ps(p0123, p4567, _MM_SHUFFLE(3, 1, 3, 1)));
+		const __m256i tagY = _mm256_slli_epi32(_mm256_cvttps_epi32(_mm256_add_ps(y, offsetY)), yShift);
+		const __m256i tagX = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(scale, x), offsetX));
+		const __m256i tags = _mm256_permute4x64_epi64(_mm256_add_epi32(tagY, tagX), _MM_SHUFFLE(3, 1, 2, 0));
+		_mm256_storeu_si256((__m256i*)(outTags + i), tags);
+	}
+	for (; i < count; ++i)
+	{
+		outTags[i] = CalculateTag(positions[i], inverseDiameter);
+	}
+	return count;
+}
+
+//==============================================================================
+// Dispatch
+//==============================================================================
+
+int CalculateTags_Simd(const b2Vec2* positions,
+					   int count,
+					   const float& inverseDiameter,
+					   uint32* outTags)
+{
+	if (b2GetParticleSimdLevel() == b2_particleSimdAvx2)
+	{
+		return CalculateTags_Avx2(positions, count, inverseDiameter, outTags);
+	}
+	return CalculateTags_Sse2(positions, count, inverseDiameter, outTags);
+}
+
+#else
+
+b2ParticleSimdLevel b2GetParticleSimdLevel()
+{
+	return b2_particleSimdNone;
+}
+
+#endif // defined(LIQUIDFUN_SIMD_X86)
@@ -28,6 +28,7 @@
 #include <Box2D/Collision/Shapes/b2EdgeShape.h>
 #include <Box2D/Collision/Shapes/b2ChainShape.h>
 #include <algorithm>
+#include <new>
 
 // Define LIQUIDFUN_SIMD_TEST_VS_REFERENCE to run both SIMD and reference
 // versions, and assert that the results are identical. This is useful when
@@ -56,6 +57,208 @@ static const uint32 relativeTagBottomLeft = (uint32)((1 << yShift) +
 
 static const uint32 relativeTagBottomRight = (1u << yShift) + (1u << xShift);
 
+// Smallest number of particles or contacts worth handing to another thread.
+static const int32 k_minParallelChunk = 1024;
+
+namespace
+{
+
+// Calls function(chunk, begin, end) for chunkCount fixed chunks of
+// [0, count). The chunk boundaries only depend on count and chunkCount, so
+// per-chunk results can be combined in the same order on every run.
+template <typename F>
+class b2ParticleChunkTask : public b2ParallelTask
+{
+public:
+	b2ParticleChunkTask(int32 count, int32 chunkCount, const F& function)
+		: m_count(count), m_chunkCount(chunkCount), m_function(function) {}
+
+	void Execute(int32 begin, int32 end, int32 threadIndex)
+	{
+		B2_NOT_USED(threadIndex);
+		for (int32 chunk = begin; chunk < end; ++chunk)
+		{
+			m_function(chunk, GetBoundary(chunk), GetBoundary(chunk + 1));
+		}
+	}
+
+private:
+	int32 GetBoundary(int32 chunk) const
+	{
+		return (int32)((int64)m_count * chunk / m_chunkCount);
+	}
+
+	int32 m_count;
+	int32 m_chunkCount;
+	const F& m_function;
+};
+
+} // namespace
+
+int32 b2ParticleSystem::GetChunkCount(int32 count) const
+{
+	const b2TaskExecutor* executor = m_world->m_taskExecutor;
+	if (executor == NULL)
+	{
+		return 1;
+	}
+	return b2Max(1, b2Min(executor->GetThreadCount(),
+						  count / k_minParallelChunk));
+}
+
+void b2ParticleSystem::ReserveChunkAllocators(int32 chunkCount) const
+{
+	if (m_chunkAllocatorCount >= chunkCount)
+	{
+		return;
+	}
+	b2BlockAllocator* allocators = (b2BlockAllocator*)
+		b2Alloc(sizeof(b2BlockAllocator) * chunkCount);
+	for (int32 i = 0; i < chunkCount; i++)
+	{
+		new (&allocators[i]) b2BlockAllocator();
+	}
+	for (int32 i = 0; i < m_chunkAllocatorCount; i++)
+	{
+		m_chunkAllocators[i].~b2BlockAllocator();
+	}
+	b2Free(m_chunkAllocators);
+	m_chunkAllocators = allocators;
+	m_chunkAllocatorCount = chunkCount;
+}
+
+template <typename F>
+void b2ParticleSystem::ForEachChunk(
+	int32 count, int32 chunkCount, const F& function) const
+{
+	if (chunkCount <= 1)
+	{
+		function(0, 0, count);
+		return;
+	}
+	b2ParticleChunkTask<F> task(count, chunkCount, function);
+	m_world->m_taskExecutor->ParallelFor(chunkCount, 1, &task);
+}
+
+template <typename F>
+void b2ParticleSystem::ParallelFor(int32 count, const F& function) const
+{
+	ForEachChunk(count, GetChunkCount(count),
+		[&function](int32 chunk, int32 begin, int32 end)
+		{
+			B2_NOT_USED(chunk);
+			function(begin, end);
+		});
+}
+
+template <typename T, typename F>
+void b2ParticleSystem::AccumulateChunks(
+	T* buffer, const T& zero, int32 count, const F& function)
+{
+	const int32 chunkCount = GetChunkCount(count);
+	if (chunkCount <= 1)
+	{
+		function(0, count, buffer);
+		return;
+	}
+	// The first chunk adds to 'buffer' directly, the others to buffers of
+	// their own which are added to 'buffer' afterwards in chunk order.
+	T* partials = (T*) m_world->m_stackAllocator.Allocate(
+		sizeof(T) * m_count * (chunkCount - 1));
+	ForEachChunk(count, chunkCount,
+		[&](int32 chunk, int32 begin, int32 end)
+		{
+			T* out = buffer;
+			if (chunk > 0)
+			{
+				out = partials + (chunk - 1) * m_count;
+				for (int32 i = 0; i < m_count; i++)
+				{
+					out[i] = zero;
+				}
+			}
+			function(begin, end, out);
+		});
+	ParallelFor(m_count, [&](int32 begin, int32 end)
+		{
+			for (int32 chunk = 1; chunk < chunkCount; chunk++)
+			{
+				const T* partial = partials + (chunk - 1) * m_count;
+				for (int32 i = begin; i < end; i++)
+				{
+					buffer[i] += partial[i];
+				}
+			}
+		});
+	m_world->m_stackAllocator.Free(partials);
+}
+
+// Calls function(begin, end, contacts, allocator) to find the contacts of
+// the particles in [begin, end) of the proxy buffer, using 'allocator' for any
+// scratch buffers.
+void* b2ParticleSystem::ReserveSimdScratch(int32 size) const
+{
+	if (m_simdScratchSize < size)
+	{
+		// Grow geometrically, since the particle count usually creeps up.
+		const int32 newSize = b2Max(size, 2 * m_simdScratchSize);
+		b2Free(m_simdScratch);
+		m_simdScratch = b2Alloc(newSize);
+		m_simdScratchSize = newSize;
+	}
+	return m_simdScratch;
+}
+
+template <typename F>
+void b2ParticleSystem::FindContactsInChunks(
+	b2GrowableBuffer<b2ParticleContact>& contacts, const F& function) const
+{
+	contacts.SetCount(0);
+	const int32 chunkCount = GetChunkCount(m_count);
+	if (chunkCount <= 1)
+	{
+		function(0, m_count, contacts, m_world->m_blockAllocator);
+		return;
+	}
+	// Each chunk of particles (in proxy order) finds its contacts into a
+	// buffer of its own. Concatenating them in chunk order gives the same
+	// contacts, in the same order, as a single chunk.
+	typedef b2GrowableBuffer<b2ParticleContact> ContactBuffer;
+	ContactBuffer* chunkContacts = (ContactBuffer*)
+		m_world->m_stackAllocator.Allocate(sizeof(ContactBuffer) * chunkCount);
+	ReserveChunkAllocators(chunkCount);
+	for (int32 chunk = 0; chunk < chunkCount; chunk++)
+	{
+		new (&chunkContacts[chunk]) ContactBuffer(m_chunkAllocators[chunk]);
+	}
+	const int32 expectedCount = contacts.GetCapacity() / chunkCount;
+	ForEachChunk(m_count, chunkCount,
+		[&](int32 chunk, int32 begin, int32 end)
+		{
+			ContactBuffer& out = chunkContacts[chunk];
+			out.Reserve(expectedCount);
+			function(begin, end, out, m_chunkAllocators[chunk]);
+		});
+	int32 totalCount = 0;
+	for (int32 chunk = 0; chunk < chunkCount; chunk++)
+	{
+		totalCount += chunkContacts[chunk].GetCount();
+	}
+	contacts.Reserve(totalCount);
+	for (int32 chunk = 0; chunk < chunkCount; chunk++)
+	{
+		ContactBuffer& chunkBuffer = chunkContacts[chunk];
+		if (chunkBuffer.GetCount() > 0)
+		{
+			memcpy(contacts.Data() + contacts.GetCount(), chunkBuffer.Data(),
+				   sizeof(b2ParticleContact) * chunkBuffer.GetCount());
+			contacts.SetCount(contacts.GetCount() + chunkBuffer.GetCount());
+		}
+		chunkBuffer.~ContactBuffer();
+	}
+	m_world->m_stackAllocator.Free(chunkContacts);
+}
+
 // This functor is passed to std::remove_if in RemoveSpuriousBodyContacts
 // to implement the algorithm described there.  It was hoisted out and friended
 // as it would not compile with g++ 4.6.3 as a local class.  It is only used in
@@ -422,6 +625,12 @@ b2ParticleSystem::b2ParticleSystem(const b2ParticleSystemDef* def,
 	m_groupCount = 0;
 	m_groupList = NULL;
 
+	m_chunkAllocators = NULL;
+	m_chunkAllocatorCount = 0;
+
+	m_simdScratch = NULL;
+	m_simdScratchSize = 0;
+
 	b2Assert(def->lifetimeGranularity > 0.0f);
 	m_def = *def;
 
@@ -460,6 +669,13 @@ b2ParticleSystem::~b2ParticleSystem()
 	FreeBuffer(&m_accumulation2Buffer, m_internalAllocatedCapacity);
 	FreeBuffer(&m_depthBuffer, m_internalAllocatedCapacity);
 	FreeBuffer(&m_groupBuffer, m_internalAllocatedCapacity);
+
+	for (int32 i = 0; i < m_chunkAllocatorCount; i++)
+	{
+		m_chunkAllocators[i].~b2BlockAllocator();
+	}
+	b2Free(m_chunkAllocators);
+	b2Free(m_simdScratch);
 }
 
 template <typename T> void b2ParticleSystem::FreeBuffer(T** b, int capacity)
@@ -1673,15 +1889,19 @@ void b2ParticleSystem::ComputeWeight()
 		float32 w = contact.weight;
 		m_weightBuffer[a] += w;
 	}
-	for (int32 k = 0; k < m_contactBuffer.GetCount(); k++)
-	{
-		const b2ParticleContact& contact = m_contactBuffer[k];
-		int32 a = contact.GetIndexA();
-		int32 b = contact.GetIndexB();
-		float32 w = contact.GetWeight();
-		m_weightBuffer[a] += w;
-		m_weightBuffer[b] += w;
-	}
+	AccumulateChunks(m_weightBuffer, 0.0f, m_contactBuffer.GetCount(),
+		[this](int32 begin, int32 end, float32* weights)
+		{
+			for (int32 k = begin; k < end; k++)
+			{
+				const b2ParticleContact& contact = m_contactBuffer[k];
+				int32 a = contact.GetIndexA();
+				int32 b = contact.GetIndexB();
+				float32 w = contact.GetWeight();
+				weights[a] += w;
+				weights[b] += w;
+			}
+		});
 }
 
 void b2ParticleSystem::ComputeDepth()
@@ -1826,11 +2046,28 @@ inline void b2ParticleSystem::AddContact(int32 a, int32 b,
 void b2ParticleSystem::FindContacts_Reference(
 	b2GrowableBuffer<b2ParticleContact>& contacts) const
 {
-	const Proxy* beginProxy = m_proxyBuffer.Begin();
+	FindContactsInChunks(contacts,
+		[this](int32 begin, int32 end,
+			   b2GrowableBuffer<b2ParticleContact>& out,
+			   b2BlockAllocator& allocator)
+		{
+			B2_NOT_USED(allocator);
+			FindContacts_Reference(begin, end, out);
+		});
+}
+
+// Find the contacts of the particles in [begin, end) of the proxy buffer with
+// the particles that follow them.
+void b2ParticleSystem::FindContacts_Reference(int32 begin, int32 end,
+	b2GrowableBuffer<b2ParticleContact>& contacts) const
+{
+	const Proxy* beginProxy = m_proxyBuffer.Begin() + begin;
+	const Proxy* lastProxy = m_proxyBuffer.Begin() + end;
 	const Proxy* endProxy = m_proxyBuffer.End();
 
-	contacts.SetCount(0);
-	for (const Proxy *a = beginProxy, *c = beginProxy; a < endProxy; a++)
+	// Proxies below and to the left of 'a' are always after 'a', so 'c' can
+	// start at the beginning of the range.
+	for (const Proxy *a = beginProxy, *c = beginProxy; a < lastProxy; a++)
 	{
 		uint32 rightTag = computeRelativeTag(a->tag, 1, 0);
 		for (const Proxy* b = a + 1; b < endProxy; b++)
@@ -1899,8 +2136,8 @@ inline void b2ParticleSystem::GatherChecksOneParticle(
 			break;
 
 		FindContactCheck& out = checks.Append();
-		out.particleIndex = (uint16)particleIndex;
-		out.comparatorIndex = (uint16)comparatorIndex;
+		out.particleIndex = (FindContactIndex)particleIndex;
+		out.comparatorIndex = (FindContactIndex)comparatorIndex;
 
 		// This is faster inside the 'for' since there are so few iterations.
 		if (nextUncheckedIndex != NULL)
@@ -1910,11 +2147,13 @@ inline void b2ParticleSystem::GatherChecksOneParticle(
 	}
 }
 
-void b2ParticleSystem::GatherChecks(
+void b2ParticleSystem::GatherChecks(int begin, int end,
 	b2GrowableBuffer<FindContactCheck>& checks) const
 {
-	int bottomLeftIndex = 0;
-	for (int particleIndex = 0; particleIndex < m_count; ++particleIndex)
+	// Particles below and to the left are always after 'particleIndex', so
+	// the search can start at the beginning of the range.
+	int bottomLeftIndex = begin;
+	for (int particleIndex = begin; particleIndex < end; ++particleIndex)
 	{
 		const uint32 particleTag = m_proxyBuffer[particleIndex].tag;
 
@@ -1967,7 +2206,7 @@ void b2ParticleSystem::FindContacts_Simd(
 	static const int MAX_EXPECTED_CHECKS_PER_PARTICLE = 3;
 	b2GrowableBuffer<FindContactCheck> checks(m_world->m_blockAllocator);
 	checks.Reserve(MAX_EXPECTED_CHECKS_PER_PARTICLE * m_count);
-	GatherChecks(checks);
+	GatherChecks(0, m_count, checks);
 
 	// Perform narrow-band contact checks using actual positions.
 	// Any particles whose centers are within one diameter of each other are
@@ -1987,6 +2226,9 @@ void b2ParticleSystem::FindContacts(
 	#if defined(LIQUIDFUN_SIMD_NEON)
 		FindContacts_Simd(contacts);
 	#else
+		// The x86 kernels only compute tags. Finding contacts is dominated
+		// by appending them, and SSE2/AVX2 versions were slower than this at
+		// every particle count measured (see b2ParticleAssembly.x86.cpp).
 		FindContacts_Reference(contacts);
 	#endif
 
@@ -2029,17 +2271,21 @@ inline b2ContactListener* b2ParticleSystem::GetParticleContactListener() const
 void b2ParticleSystem::UpdateProxies_Reference(
 	b2GrowableBuffer<Proxy>& proxies) const
 {
-	const Proxy* const endProxy = proxies.End();
-	for (Proxy* proxy = proxies.Begin(); proxy < endProxy; ++proxy)
-	{
-		int32 i = proxy->index;
-		b2Vec2 p = m_positionBuffer.data[i];
-		proxy->tag = computeTag(m_inverseDiameter * p.x,
-								m_inverseDiameter * p.y);
-	}
+	ParallelFor(proxies.GetCount(), [&](int32 begin, int32 end)
+		{
+			const Proxy* const endProxy = proxies.Begin() + end;
+			for (Proxy* proxy = proxies.Begin() + begin; proxy < endProxy;
+				 ++proxy)
+			{
+				int32 i = proxy->index;
+				b2Vec2 p = m_positionBuffer.data[i];
+				proxy->tag = computeTag(m_inverseDiameter * p.x,
+										m_inverseDiameter * p.y);
+			}
+		});
 }
 
-#if defined(LIQUIDFUN_SIMD_NEON)
+#if defined(LIQUIDFUN_SIMD_NEON) || defined(LIQUIDFUN_SIMD_X86)
 // static
 void b2ParticleSystem::UpdateProxyTags(
 	const uint32* const tags,
@@ -2055,8 +2301,7 @@ void b2ParticleSystem::UpdateProxyTags(
 void b2ParticleSystem::UpdateProxies_Simd(
 	b2GrowableBuffer<Proxy>& proxies) const
 {
-	uint32* tags = (uint32*)
-		m_world->m_stackAllocator.Allocate(m_count * sizeof(uint32));
+	uint32* tags = (uint32*)ReserveSimdScratch(m_count * sizeof(uint32));
 
 	// Calculate tag for every position.
 	// 'tags' array is in position-order.
@@ -2065,10 +2310,8 @@ void b2ParticleSystem::UpdateProxies_Simd(
 
 	// Update 'tag' element in the 'proxies' array to the new values.
 	UpdateProxyTags(tags, proxies);
-
-	m_world->m_stackAllocator.Free(tags);
 }
-#endif // defined(LIQUIDFUN_SIMD_NEON)
+#endif // defined(LIQUIDFUN_SIMD_NEON) || defined(LIQUIDFUN_SIMD_X86)
 
 // static
 bool b2ParticleSystem::ProxyBufferHasIndex(
@@ -2136,6 +2379,15 @@ void b2ParticleSystem::UpdateProxies(
 
 	#if defined(LIQUIDFUN_SIMD_NEON)
 		UpdateProxies_Simd(proxies);
+	#elif defined(LIQUIDFUN_SIMD_X86)
+		if (b2GetParticleSimdLevel() != b2_particleSimdNone)
+		{
+			UpdateProxies_Simd(proxies);
+		}
+		else
+		{
+			UpdateProxies_Reference(proxies);
+		}
 	#else
 		UpdateProxies_Reference(proxies);
 	#endif
@@ -3087,10 +3339,14 @@ void b2ParticleSystem::Solve(const b2TimeStep& step)
 			SolveWall();
 		}
 		// The particle positions can be updated only at the end of substep.
-		for (int32 i = 0; i < m_count; i++)
-		{
-			m_positionBuffer.data[i] += subStep.dt * m_velocityBuffer.data[i];
-		}
+		ParallelFor(m_count, [&](int32 begin, int32 end)
+			{
+				for (int32 i = begin; i < end; i++)
+				{
+					m_positionBuffer.data[i] +=
+						subStep.dt * m_velocityBuffer.data[i];
+				}
+			});
 	}
 }
 
@@ -3118,24 +3374,30 @@ void b2ParticleSystem::UpdateAllGroupFlags()
 void b2ParticleSystem::LimitVelocity(const b2TimeStep& step)
 {
 	float32 criticalVelocitySquared = GetCriticalVelocitySquared(step);
-	for (int32 i = 0; i < m_count; i++)
-	{
-		b2Vec2& v = m_velocityBuffer.data[i];
-		float32 v2 = b2Dot(v, v);
-		if (v2 > criticalVelocitySquared)
+	ParallelFor(m_count, [&](int32 begin, int32 end)
 		{
-			v *= b2Sqrt(criticalVelocitySquared / v2);
-		}
-	}
+			for (int32 i = begin; i < end; i++)
+			{
+				b2Vec2& v = m_velocityBuffer.data[i];
+				float32 v2 = b2Dot(v, v);
+				if (v2 > criticalVelocitySquared)
+				{
+					v *= b2Sqrt(criticalVelocitySquared / v2);
+				}
+			}
+		});
 }
 
 void b2ParticleSystem::SolveGravity(const b2TimeStep& step)
 {
 	b2Vec2 gravity = step.dt * m_def.gravityScale * m_world->GetGravity();
-	for (int32 i = 0; i < m_count; i++)
-	{
-		m_velocityBuffer.data[i] += gravity;
-	}
+	ParallelFor(m_count, [&](int32 begin, int32 end)
+		{
+			for (int32 i = begin; i < end; i++)
+			{
+				m_velocityBuffer.data[i] += gravity;
+			}
+		});
 }
 
 void b2ParticleSystem::SolveStaticPressure(const b2TimeStep& step)
@@ -3198,35 +3460,40 @@ void b2ParticleSystem::SolvePressure(const b2TimeStep& step)
 	float32 criticalPressure = GetCriticalPressure(step);
 	float32 pressurePerWeight = m_def.pressureStrength * criticalPressure;
 	float32 maxPressure = b2_maxParticlePressure * criticalPressure;
-	for (int32 i = 0; i < m_count; i++)
-	{
-		float32 w = m_weightBuffer[i];
-		float32 h = pressurePerWeight * b2Max(0.0f, w - b2_minParticleWeight);
-		m_accumulationBuffer[i] = b2Min(h, maxPressure);
-	}
-	// ignores particles which have their own repulsive force
-	if (m_allParticleFlags & k_noPressureFlags)
-	{
-		for (int32 i = 0; i < m_count; i++)
+	b2Assert(m_staticPressureBuffer ||
+			 !(m_allParticleFlags & b2_staticPressureParticle));
+	ParallelFor(m_count, [&](int32 begin, int32 end)
 		{
-			if (m_flagsBuffer.data[i] & k_noPressureFlags)
+			for (int32 i = begin; i < end; i++)
 			{
-				m_accumulationBuffer[i] = 0;
+				float32 w = m_weightBuffer[i];
+				float32 h = pressurePerWeight *
+					b2Max(0.0f, w - b2_minParticleWeight);
+				m_accumulationBuffer[i] = b2Min(h, maxPressure);
 			}
-		}
-	}
-	// static pressure
-	if (m_allParticleFlags & b2_staticPressureParticle)
-	{
-		b2Assert(m_staticPressureBuffer);
-		for (int32 i = 0; i < m_count; i++)
-		{
-			if (m_flagsBuffer.data[i] & b2_staticPressureParticle)
+			// ignores particles which have their own repulsive force
+			if (m_allParticleFlags & k_noPressureFlags)
+			{
+				for (int32 i = begin; i < end; i++)
+				{
+					if (m_flagsBuffer.data[i] & k_noPressureFlags)
+					{
+						m_accumulationBuffer[i] = 0;
+					}
+				}
+			}
+			// static pressure
+			if (m_allParticleFlags & b2_staticPressureParticle)
 			{
-				m_accumulationBuffer[i] += m_staticPressureBuffer[i];
+				for (int32 i = begin; i < end; i++)
+				{
+					if (m_flagsBuffer.data[i] & b2_staticPressureParticle)
+					{
+						m_accumulationBuffer[i] += m_staticPressureBuffer[i];
+					}
+				}
 			}
-		}
-	}
+		});
 	// applies pressure between each particles in contact
 	float32 velocityPerPressure = step.dt / (m_def.density * m_particleDiameter);
 	for (int32 k = 0; k < m_bodyContactBuffer.GetCount(); k++)
@@ -3243,18 +3510,23 @@ void b2ParticleSystem::SolvePressure(const b2TimeStep& step)
 		m_velocityBuffer.data[a] -= GetParticleInvMass() * f;
 		b->ApplyLinearImpulse(f, p, true);
 	}
-	for (int32 k = 0; k < m_contactBuffer.GetCount(); k++)
-	{
-		const b2ParticleContact& contact = m_contactBuffer[k];
-		int32 a = contact.GetIndexA();
-		int32 b = contact.GetIndexB();
-		float32 w = contact.GetWeight();
-		b2Vec2 n = contact.GetNormal();
-		float32 h = m_accumulationBuffer[a] + m_accumulationBuffer[b];
-		b2Vec2 f = velocityPerPressure * w * h * n;
-		m_velocityBuffer.data[a] -= f;
-		m_velocityBuffer.data[b] += f;
-	}
+	AccumulateChunks(m_velocityBuffer.data, b2Vec2_zero,
+		m_contactBuffer.GetCount(),
+		[&](int32 begin, int32 end, b2Vec2* velocities)
+		{
+			for (int32 k = begin; k < end; k++)
+			{
+				const b2ParticleContact& contact = m_contactBuffer[k];
+				int32 a = contact.GetIndexA();
+				int32 b = contact.GetIndexB();
+				float32 w = contact.GetWeight();
+				b2Vec2 n = contact.GetNormal();
+				float32 h = m_accumulationBuffer[a] + m_accumulationBuffer[b];
+				b2Vec2 f = velocityPerPressure * w * h * n;
+				velocities[a] -= f;
+				velocities[b] += f;
+			}
+		});
 }
 
 void b2ParticleSystem::SolveDamping(const b2TimeStep& step)
@@ -935,6 +935,12 @@ private:
 		b2GrowableBuffer<b2ParticleContact>& contacts) const;
 	void FindContacts_Reference(
 		b2GrowableBuffer<b2ParticleContact>& contacts) const;
+	void FindContacts_Reference(int32 begin, int32 end,
+		b2GrowableBuffer<b2ParticleContact>& contacts) const;
+	template <typename F>
+	void FindContactsInChunks(
+		b2GrowableBuffer<b2ParticleContact>& contacts,
+		const F& function) const;
 	void ReorderForFindContact(FindContactInput* reordered,
 		                       int alignedCount) const;
 	void GatherChecksOneParticle(
@@ -943,7 +949,8 @@ private:
 		const int particleIndex,
 		int* nextUncheckedIndex,
 		b2GrowableBuffer<FindContactCheck>& checks) const;
-	void GatherChecks(b2GrowableBuffer<FindContactCheck>& checks) const;
+	void GatherChecks(int begin, int end,
+		b2GrowableBuffer<FindContactCheck>& checks) const;
 	void FindContacts_Simd(
 		b2GrowableBuffer<b2ParticleContact>& contacts) const;
 	void FindContacts(
@@ -959,6 +966,7 @@ private:
 								   	   const b2GrowableBuffer<Proxy>& b);
 	void UpdateProxies_Reference(b2GrowableBuffer<Proxy>& proxies) const;
 	void UpdateProxies_Simd(b2GrowableBuffer<Proxy>& proxies) const;
+	void* ReserveSimdScratch(int32 size) const;
 	void UpdateProxies(b2GrowableBuffer<Proxy>& proxies) const;
 	void SortProxies(b2GrowableBuffer<Proxy>& proxies) const;
 	void FilterContacts(b2GrowableBuffer<b2ParticleContact>& contacts);
@@ -971,6 +979,29 @@ private:
 	void NotifyBodyContactListenerPostContact(FixtureParticleSet& fixtureSet);
 	void UpdateBodyContacts();
 
+	/// Number of chunks to split count particles or contacts into across
+	/// the world's task executor. It only depends on count and the thread
+	/// count, so results combined over chunks are deterministic for a fixed
+	/// thread count.
+	int32 GetChunkCount(int32 count) const;
+	/// Make sure there's a block allocator for each of chunkCount chunks.
+	void ReserveChunkAllocators(int32 chunkCount) const;
+	/// Call function(chunk, begin, end) for each of chunkCount chunks of
+	/// [0, count), concurrently on the world's task executor.
+	template <typename F>
+	void ForEachChunk(int32 count, int32 chunkCount, const F& function) const;
+	/// Call function(begin, end) for chunks of [0, count), concurrently on
+	/// the world's task executor.
+	template <typename F>
+	void ParallelFor(int32 count, const F& function) const;
+	/// Call function(begin, end, out) for chunks of [0, count) to add
+	/// per-particle contributions to 'out'. Chunks other than the first add
+	/// to zeroed buffers of their own which are added to 'buffer' afterwards
+	/// in chunk order.
+	template <typename T, typename F>
+	void AccumulateChunks(T* buffer, const T& zero, int32 count,
+						  const F& function);
+
 	void Solve(const b2TimeStep& step);
 	void SolveCollision(const b2TimeStep& step);
 	void LimitVelocity(const b2TimeStep& step);
@@ -1141,6 +1172,16 @@ private:
 	int32 m_groupCount;
 	b2ParticleGroup* m_groupList;
 
+	/// Block allocators for the scratch buffers of each chunk of a parallel
+	/// stage, since the world's block allocator isn't thread safe.
+	mutable b2BlockAllocator* m_chunkAllocators;
+	mutable int32 m_chunkAllocatorCount;
+
+	/// Scratch memory of the SIMD kernels, kept between steps since it is
+	/// usually too large for the world's stack allocator.
+	mutable void* m_simdScratch;
+	mutable int32 m_simdScratchSize;
+
 	b2ParticleSystemDef m_def;
 
 	b2World* m_world;
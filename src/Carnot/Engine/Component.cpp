@@ -1,6 +1,7 @@
 #include <Engine/Component.hpp>
 #include <Engine/Object.hpp>
 #include <Engine/GameObject.hpp>
+#include <Engine/ComponentRegistry.hpp>
 
 namespace carnot {
 
@@ -15,12 +16,14 @@ Component::Component(GameObject& _gameObject) :
     Object(),
     gameObject(_gameObject),
     m_startCalled(false),
-    m_index(0)
+    m_index(0),
+    m_registryIndex(detail::ComponentRegistry::npos)
 {
     g_componentCount++;
 }
 
 Component::~Component() {
+    detail::ComponentRegistry::remove(this);
     g_componentCount--;
 }
 
@@ -61,6 +64,11 @@ void Component::updateAll() {
     }
 }
 
+void Component::refreshTicks(bool subtree) {
+    // Components are listed with their GameObject's own entries
+    gameObject.refreshTicks(false);
+}
+
 std::size_t Component::getComponentCount() {
     return g_componentCount;
 }
@@ -0,0 +1,84 @@
+#include <Engine/ComponentRegistry.hpp>
+#include <algorithm>
+
+namespace carnot {
+namespace detail {
+
+//==============================================================================
+// GLOBALS
+//==============================================================================
+
+namespace {
+
+std::size_t g_count      = 0;     ///< number of registered Components
+std::size_t g_iterating  = 0;     ///< nesting depth of each() calls
+bool        g_tombstones = false; ///< true if removals were deferred
+
+} // private namespace
+
+//==============================================================================
+// COMPONENT REGISTRY
+//==============================================================================
+
+std::vector<std::vector<Component*>>& ComponentRegistry::arrays() {
+    static std::vector<std::vector<Component*>> s_arrays;
+    return s_arrays;
+}
+
+void ComponentRegistry::add(Component* component) {
+    TypeId id = component->getTypeId();
+    if (id == InvalidTypeId || component->m_registryIndex != npos)
+        return;
+    auto& all = arrays();
+    if (id >= all.size())
+        all.resize(id + 1);
+    component->m_registryIndex = all[id].size();
+    all[id].push_back(component);
+    g_count++;
+}
+
+void ComponentRegistry::remove(Component* component) {
+    if (component->m_registryIndex == npos)
+        return;
+    auto& array = arrays()[component->getTypeId()];
+    if (g_iterating > 0) {
+        // defer compaction so indices stay stable during each()
+        array[component->m_registryIndex] = nullptr;
+        g_tombstones = true;
+    }
+    else {
+        // swap-remove
+        array[component->m_registryIndex] = array.back();
+        array[component->m_registryIndex]->m_registryIndex = component->m_registryIndex;
+        array.pop_back();
+    }
+    component->m_registryIndex = npos;
+    g_count--;
+}
+
+std::size_t ComponentRegistry::count() {
+    return g_count;
+}
+
+void ComponentRegistry::beginIteration() {
+    g_iterating++;
+}
+
+void ComponentRegistry::endIteration() {
+    if (--g_iterating > 0 || !g_tombstones)
+        return;
+    for (auto& array : arrays()) {
+        auto end = std::remove(array.begin(), array.end(), nullptr);
+        array.erase(end, array.end());
+        for (std::size_t i = 0; i < array.size(); ++i)
+            array[i]->m_registryIndex = i;
+    }
+    g_tombstones = false;
+}
+
+bool ComponentRegistry::hasTombstones() {
+    return g_tombstones;
+}
+
+} // namespace detail
+} // namespace carnot
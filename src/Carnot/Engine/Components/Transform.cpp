@@ -1,32 +1,43 @@
 #include <Engine/Components/Transform.hpp>
+#include <Engine/TransformSystem.hpp>
 #include <Engine/GameObject.hpp>
 #include <Engine/Engine.hpp>
 #include <Utility/Math.hpp>
+#include <Utility/DeferQueue.hpp>
 #include <ImGui/imgui.h>
 #include <Graphics/NamedColors.hpp>
 
 namespace carnot {
 
+namespace {
+
+std::size_t g_pass       = 0;          ///< processChanges pass counter
+std::vector<Transform*> g_changed;     ///< Transforms mutated since the last processChanges
+
+inline Transforms::detail::Store& store() {
+    return Transforms::detail::store();
+}
+
+} // private namespace
+
 //==============================================================================
 // Constructor
 //==============================================================================
 
 Transform::Transform(GameObject& _gameObject) :
     Component(_gameObject),
-    m_origin(0, 0),
-    m_position(0, 0),
-    m_rotation(0),
-    m_scale(1, 1),
-    m_localTransform(),
-    m_worldTransform(),
-    m_invLocalTransform(),
-    m_invWorldTransform(),
-    m_localTransformDirty(true),
-    m_worldTransformDirty(true),
-    m_invLocalTransformDirty(true),
-    m_invWorldTransformDirty(true)
+    m_slot(store().allocate(this)),
+    m_notifiedVersion(0),
+    m_notifiedPass(0),
+    m_changeIndex(npos)
 {
-    
+
+}
+
+Transform::~Transform() {
+    store().release(m_slot);
+    if (m_changeIndex != npos)
+        g_changed[m_changeIndex] = nullptr;
 }
 
 //==============================================================================
@@ -34,8 +45,7 @@ Transform::Transform(GameObject& _gameObject) :
 //==============================================================================
 
 void Transform::setLocalPosition(float x, float y) {
-    m_position.x = x;
-    m_position.y = y;
+    store().position[m_slot] = Vector2f(x, y);
     makeDirty();
 }
 
@@ -44,15 +54,15 @@ void Transform::setLocalPosition(const Vector2f& position) {
 }
 
 void Transform::setLocalRotation(float angle) {
-    m_rotation = static_cast<float>(fmod(angle, 360));
-    if (m_rotation < 0)
-        m_rotation += 360.f;
+    float rotation = static_cast<float>(fmod(angle, 360));
+    if (rotation < 0)
+        rotation += 360.f;
+    store().rotation[m_slot] = rotation;
     makeDirty();
 }
 
 void Transform::setLocalScale(float factorX, float factorY) {
-    m_scale.x = factorX;
-    m_scale.y = factorY;
+    store().scale[m_slot] = Vector2f(factorX, factorY);
     makeDirty();
 }
 
@@ -61,8 +71,7 @@ void Transform::setLocalScale(const Vector2f& factors) {
 }
 
 void Transform::setLocalOrigin(float x, float y) {
-    m_origin.x = x;
-    m_origin.y = y;
+    store().origin[m_slot] = Vector2f(x, y);
     makeDirty();
 }
 
@@ -70,74 +79,60 @@ void Transform::setLocalOrigin(const Vector2f& origin) {
     setLocalOrigin(origin.x, origin.y);
 }
 
-const Vector2f& Transform::getLocalPosition() const {
-    return m_position;
+Vector2f Transform::getLocalPosition() const {
+    return store().position[m_slot];
 }
 
 float Transform::getLocalRotation() const {
-    return m_rotation;
+    return store().rotation[m_slot];
 }
 
-const Vector2f& Transform::getLocalScale() const {
-    return m_scale;
+Vector2f Transform::getLocalScale() const {
+    return store().scale[m_slot];
 }
 
-const Vector2f& Transform::getLocalOrigin() const {
-    return m_origin;
+Vector2f Transform::getLocalOrigin() const {
+    return store().origin[m_slot];
 }
 
 void Transform::move(float offsetX, float offsetY) {
-    setLocalPosition(m_position.x + offsetX, m_position.y + offsetY);
+    auto position = getLocalPosition();
+    setLocalPosition(position.x + offsetX, position.y + offsetY);
 }
 
 
 void Transform::move(const Vector2f& offset) {
-    setLocalPosition(m_position.x + offset.x, m_position.y + offset.y);
+    move(offset.x, offset.y);
 }
 
 void Transform::rotate(float angle) {
-    setLocalRotation(m_rotation + angle);}
+    setLocalRotation(getLocalRotation() + angle);
+}
 
 
 void Transform::scale(float factorX, float factorY) {
-    setLocalScale(m_scale.x * factorX, m_scale.y * factorY);
+    auto scale = getLocalScale();
+    setLocalScale(scale.x * factorX, scale.y * factorY);
 }
 
 void Transform::scale(const Vector2f& factor) {
-    setLocalScale(m_scale.x * factor.x, m_scale.y * factor.y);
+    scale(factor.x, factor.y);
 }
 
-const Matrix3x3& Transform::getLocalMatrix() const
-{
-    // Recompute the combined transform if needed
-    if (m_localTransformDirty)
-    {
-        float angle = -m_rotation * 3.141592654f / 180.f;
-        float cosine = static_cast<float>(std::cos(angle));
-        float sine = static_cast<float>(std::sin(angle));
-        float sxc = m_scale.x * cosine;
-        float syc = m_scale.y * cosine;
-        float sxs = m_scale.x * sine;
-        float sys = m_scale.y * sine;
-        float tx = -m_origin.x * sxc - m_origin.y * sys + m_position.x;
-        float ty = m_origin.x * sxs - m_origin.y * syc + m_position.y;
-
-        m_localTransform = Matrix3x3(sxc, sys, tx,
-                               -sxs, syc, ty,
-                                0.f, 0.f, 1.f);
-        m_localTransformDirty = false;
-    }
+Matrix3x3 Transform::getLocalMatrix() const {
+    return getLocalAffine().toMatrix3x3();
+}
 
-    return m_localTransform;
+Matrix3x3 Transform::getInverseLocalMatrix() const {
+    return getLocalAffine().getInverse().toMatrix3x3();
 }
 
-const Matrix3x3& Transform::getInverseLocalMatrix() const {
-    // Recompute the inverse transform if needed
-    if (m_invLocalTransformDirty) {
-        m_invLocalTransform = getLocalMatrix().getInverse();
-        m_invLocalTransformDirty = false;
-    }
-    return m_invLocalTransform;
+Affine Transform::getLocalAffine() const {
+    auto& s = store();
+    if (s.localDirty[m_slot])
+        s.validate(m_slot);
+    return Affine(s.l00[m_slot], s.l01[m_slot], s.l02[m_slot],
+                  s.l10[m_slot], s.l11[m_slot], s.l12[m_slot]);
 }
 
 //==============================================================================
@@ -145,19 +140,34 @@ const Matrix3x3& Transform::getInverseLocalMatrix() const {
 //==============================================================================
 
 Matrix3x3 Transform::getWorldMatrix() const {
-    Matrix3x3 matrix = Matrix3x3::Identity;
-    for (const GameObject* node = &gameObject; node != nullptr; node = node->m_parent)
-        matrix = node->transform.getLocalMatrix() * matrix;
-    return matrix;
+    return getWorldAffine().toMatrix3x3();
 }
 
 Matrix3x3 Transform::getInverseWorldMatrix() const {
-    return getWorldMatrix().getInverse();
+    return getInverseWorldAffine().toMatrix3x3();
+}
+
+Affine Transform::getWorldAffine() const {
+    auto& s = store();
+    s.validate(m_slot);
+    return Affine(s.w00[m_slot], s.w01[m_slot], s.w02[m_slot],
+                  s.w10[m_slot], s.w11[m_slot], s.w12[m_slot]);
+}
+
+Affine Transform::getInverseWorldAffine() const {
+    return getWorldAffine().getInverse();
+}
+
+std::size_t Transform::getVersion() const {
+    store().validate(m_slot);
+    return store().worldVersion[m_slot];
 }
 
 void Transform::setPosition(const Vector2f& position) {
-    auto parentMatrix = getInverseWorldMatrix() * getLocalMatrix();
-    setLocalPosition(parentMatrix.transformPoint(position));
+    if (gameObject.m_parent != nullptr)
+        setLocalPosition(gameObject.m_parent->transform.getInverseWorldAffine().transformPoint(position));
+    else
+        setLocalPosition(position);
 }
 
 void Transform::setPosition(float x, float y) {
@@ -165,7 +175,11 @@ void Transform::setPosition(float x, float y) {
 }
 
 Vector2f Transform::getPosition() const {
-    return getWorldMatrix() * getLocalOrigin();
+    auto& s = store();
+    s.validate(m_slot);
+    const Vector2f& o = s.origin[m_slot];
+    return Vector2f(s.w00[m_slot] * o.x + s.w01[m_slot] * o.y + s.w02[m_slot],
+                    s.w10[m_slot] * o.x + s.w11[m_slot] * o.y + s.w12[m_slot]);
 }
 
 void Transform::setRotation(float angle) {
@@ -173,14 +187,32 @@ void Transform::setRotation(float angle) {
 }
 
 float Transform::getRotation() const {
-    auto m = getWorldMatrix().getMatrix();
-    float angle = std::atan2(m[1] , m[5]) * Math::RAD2DEG;
+    auto& s = store();
+    s.validate(m_slot);
+    float angle = std::atan2(s.w10[m_slot], s.w11[m_slot]) * Math::RAD2DEG;
     angle = static_cast<float>(fmod(angle, 360));
     if (angle < 0)
         angle += 360.f;
     return angle;
 }
 
+void Transform::setPositionAndRotation(const Vector2f& position, float angle) {
+    Vector2f localPosition = position;
+    float localAngle = angle;
+    if (gameObject.m_parent != nullptr) {
+        auto& parent = gameObject.m_parent->transform;
+        localPosition = parent.getInverseWorldAffine().transformPoint(position);
+        localAngle -= parent.getRotation();
+    }
+    localAngle = static_cast<float>(fmod(localAngle, 360));
+    if (localAngle < 0)
+        localAngle += 360.f;
+    auto& s = store();
+    s.position[m_slot] = localPosition;
+    s.rotation[m_slot] = localAngle;
+    makeDirty();
+}
+
 void Transform::setScale(float factorX, float factorY) {
     setScale(Vector2f(factorX, factorY));
 }
@@ -194,10 +226,11 @@ void Transform::setScale(const Vector2f& factors) {
 }
 
 const Vector2f Transform::getScale() const {
-    auto m = getWorldMatrix().getMatrix();
+    auto& s = store();
+    s.validate(m_slot);
     Vector2f scale;
-    scale.x = std::sqrt(m[0] * m[0] + m[1] * m[1]);
-    scale.y = std::sqrt(m[4] * m[4] + m[5] * m[5]);
+    scale.x = std::sqrt(s.w00[m_slot] * s.w00[m_slot] + s.w10[m_slot] * s.w10[m_slot]);
+    scale.y = std::sqrt(s.w01[m_slot] * s.w01[m_slot] + s.w11[m_slot] * s.w11[m_slot]);
     return scale;
 }
 
@@ -205,29 +238,23 @@ const Vector2f Transform::getScale() const {
 // Utility Functions
 //==========================================================================
 
-// SFML Transform.getMatrix()
-//     m_localTransform.getMatrix();
-//     [m0  m4  m8  m12]    []
-//     [m1  m5  m9  m13]
-//     [m2  m6  m10 m14]
-//     [m3  m4  m11 m15]
-
 Vector2f Transform::localToWorld(const Vector2f& point) {
-    return getWorldMatrix().transformPoint(point);
+    auto& s = store();
+    s.validate(m_slot);
+    return Vector2f(s.w00[m_slot] * point.x + s.w01[m_slot] * point.y + s.w02[m_slot],
+                    s.w10[m_slot] * point.x + s.w11[m_slot] * point.y + s.w12[m_slot]);
 }
 
 FloatRect Transform::localToWorld(const FloatRect& rect) {
-    return getWorldMatrix().transformRect(rect);
+    return getWorldAffine().transformRect(rect);
 }
 
 Vector2f Transform::worldToLocal(const Vector2f& point) {
-    return getInverseWorldMatrix().transformPoint(point);
+    return getInverseWorldAffine().transformPoint(point);
 }
 
 FloatRect Transform::worldToLocal(const FloatRect& rect) {
-    return getInverseWorldMatrix().transformRect(rect);
-
-    m_localTransform.getMatrix();
+    return getInverseWorldAffine().transformRect(rect);
 }
 
 //==============================================================================
@@ -252,16 +279,58 @@ void Transform::onGizmo() {
 }
 
 void Transform::makeDirty() {
-    m_localTransformDirty = true;
-    m_invLocalTransformDirty = true;
-    m_worldTransformDirty = true;
-    m_invWorldTransformDirty = true;
-    // call our callbacks
-    onChanged.emit();
-    // ditry children
-    for (std::size_t i = 0; i < gameObject.getChildCount(); ++i)
-        gameObject.getChild(i)->transform.makeDirty();
+    store().makeLocalDirty(m_slot);
+    makeWorldDirty();
+}
+
+void Transform::makeWorldDirty() {
+    store().makeWorldDirty(m_slot);
+    // que for onChanged notification (once per frame)
+    if (m_changeIndex == npos) {
+        if (auto queue = detail::deferQueue()) {
+            // parallel update, so que in order at the merge point
+            queue->push_back([this]() { makeWorldDirty(); });
+            return;
+        }
+        m_changeIndex = g_changed.size();
+        g_changed.push_back(this);
+    }
 }
 
-} // namespace carnot
+void Transform::updateParent() {
+    auto parent = gameObject.m_parent;
+    store().setParent(m_slot, parent != nullptr ? parent->transform.m_slot : Transforms::detail::Store::npos);
+    makeWorldDirty();
+}
+
+void Transform::processChanges() {
+    ++g_pass;
+    // listeners may mutate Transforms; those are qued behind count for next frame
+    std::size_t count = g_changed.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (g_changed[i] != nullptr) {
+            g_changed[i]->m_changeIndex = npos;
+            g_changed[i]->notifyChanged(g_pass);
+        }
+    }
+    g_changed.erase(g_changed.begin(), g_changed.begin() + count);
+    for (std::size_t i = 0; i < g_changed.size(); ++i) {
+        if (g_changed[i] != nullptr)
+            g_changed[i]->m_changeIndex = i;
+    }
+}
 
+void Transform::notifyChanged(std::size_t pass) {
+    // skip subtrees already visited from a changed ancestor this pass
+    if (m_notifiedPass == pass)
+        return;
+    m_notifiedPass = pass;
+    if (onChanged.size() > 0 && getVersion() != m_notifiedVersion) {
+        m_notifiedVersion = getVersion();
+        onChanged.emit();
+    }
+    for (auto& child : gameObject.m_children)
+        child->transform.notifyChanged(pass);
+}
+
+} // namespace carnot
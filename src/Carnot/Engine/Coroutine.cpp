@@ -51,7 +51,7 @@ SuspendAlawys PromiseType::final_suspend() {
 
 Enumerator PromiseType::get_return_object() {
     auto h = std::experimental::coroutine_handle<PromiseType>::from_promise(*this);
-    Ptr<Coroutine> coro(new Coroutine(h));
+    Ptr<Coroutine> coro(new Coroutine(h), detail::TrackedDelete());
     return Enumerator(coro);
 }
 
@@ -64,7 +64,7 @@ SuspendNever PromiseType::return_void() {
 }
 
 SuspendAlawys PromiseType::yield_value(YieldInstruction* value) {
-   m_instruction = std::shared_ptr<YieldInstruction>(value);
+   m_instruction = std::shared_ptr<YieldInstruction>(value, detail::TrackedDelete());
    return SuspendAlawys{};
 }
 
@@ -6,9 +6,11 @@
 #include <iomanip>
 #include <iostream>
 #include <Graphics/Components/Renderer.hpp>
+#include <Geometry/MeshCache.hpp>
 #include <Physics/Components/RigidBody.hpp>
 #include <Physics/Components/ParticleSystem.hpp>
 #include <Utility/Math.hpp>
+#include <Utility/PoolAllocator.hpp>
 #include <ImGui/imgui.h>
 #include <ImGui/imgui-SFML.h>
 #include <Engine/IconsFontAwesome5.hpp>
@@ -305,6 +307,14 @@ void infoMenu() {
         tooltip("Total Object count");
         ImGui::Text("RND: %i", (int)Renderer::getRendererCount());
         tooltip("Total Renderer count");
+        ImGui::Text("UPL: %.1f KB", Renderer::getUploadedBytes() / 1024.0f);
+        tooltip("Vertex data uploaded to the GPU last frame");
+        ImGui::Text("DRW: %i", (int)Renderer::getDrawnCount());
+        tooltip("Renderers drawn last frame (all Views)");
+        ImGui::Text("CUL: %i", (int)Renderer::getCulledCount());
+        tooltip("Renderers culled outside of the Views last frame");
+        ImGui::Text("MSH: %i", (int)MeshCache::getMeshCount());
+        tooltip("Shared Shape Meshes cached");
         ImGui::Text("BDY: %i", (int)RigidBody::getRigidBodyCount());
         tooltip("Total RigidBody count");
         ImGui::Text("BDY: %i", (int)ParticleSystem::getParticleCount());
@@ -339,6 +349,28 @@ void gizmoMenu() {
     ImGui::End();
 }
 
+void poolMenu() {
+    static int corner = 2;
+    ImGuiIO& io = ImGui::GetIO();
+    ImVec2 window_pos = ImVec2((corner & 1) ? io.DisplaySize.x - g_windowDistance : g_windowDistance, (corner & 2) ? io.DisplaySize.y - g_windowDistance : g_windowDistance);
+    ImVec2 window_piv = ImVec2((corner & 1) ? 1.0f : 0.0f, (corner & 2) ? 1.0f : 0.0f);
+    if (corner != -1)
+        ImGui::SetNextWindowPos(window_pos, ImGuiCond_Always, window_piv);
+    if (ImGui::Begin("Pools##CARNOT_DEBUG", nullptr, (corner != -1 ? ImGuiWindowFlags_NoMove : 0) | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        for (auto& pool : MemoryPool::getAllStats()) {
+            ImGui::Text("%-24.24s %6i/%-6i %3i%%", pool.name.c_str(), (int)pool.used, (int)pool.capacity, (int)(pool.fragmentation * 100));
+            tooltip(pool.name + "\n" + 
+                    "Block Size: " + std::to_string(pool.blockSize) + " B\n" +
+                    "Peak Used:  " + std::to_string(pool.peak) + "\n" +
+                    "Chunks:     " + std::to_string(pool.chunks) + "\n" +
+                    "Free:       " + std::to_string((int)(pool.fragmentation * 100)) + "%%");
+        }
+        showContextMenu(corner);
+    }
+    ImGui::End();
+}
+
 void toolbarMenu() {
     ImGuiIO& io = ImGui::GetIO();
     ImVec2 window_pos = ImVec2(io.DisplaySize.x * 0.5f, g_windowDistance);
@@ -474,6 +506,7 @@ void update() {
         // imgui
         infoMenu();
         gizmoMenu();
+        poolMenu();
         toolbarMenu();
         // draw drawables
         if (g_triangles.size() > 0)
@@ -4,11 +4,15 @@
 #include <cassert>
 #include "Fonts/EngineFonts.hpp"
 #include <Graphics/Components/Renderer.hpp>
+#include <Graphics/RenderBatch.hpp>
 #include <ImGui/imgui.h>
 #include <ImGui/imgui-SFML.h>
 #include <Engine/IconsFontAwesome5.hpp>
 #include <Engine/IconsFontAwesome5Brands.hpp>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <thread>
 #include "SPSCQueue.hpp"
 
@@ -31,15 +35,21 @@ std::atomic<bool> g_initialized = false;
 std::atomic<bool> g_running     = false; 
 float             g_time        = 0.0f;
 float             g_delta       = 0.0f;
+float             g_budget      = 0.0f;
 std::size_t       g_frame       = 0;
 float             g_dpiFactor   = 1.0f;
 std::vector<View> g_views       = std::vector<View>(1);
 RenderQue         g_renderQue   = RenderQue(1);
+RenderBatch       g_renderBatch;
+std::vector<const Renderer*> g_visible;    ///< Renderers visible in a View
 Color             g_bgColor     = Color();
 Clock             g_clock       = Clock();
 Ptr<GameObject>   g_root;
+Ptr<JobSystem>    g_jobs;
 SPSCQueue<Event>  g_eventQue(256);          
 
+thread_local float g_tickDelta = -1.0f; ///< per thread, since throttled updates may run in parallel
+
 unsigned char white_pixel[] = {
     0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
     0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01,
@@ -142,7 +152,13 @@ void setUserIcon(sf::WindowHandle handle) {}
 
 #endif
 
-
+/// Gets the axis aligned world rectangle visible through a (possibly rotated) View
+FloatRect visibleRect(const View& view) {
+    Vector2f size(std::abs(view.getSize().x), std::abs(view.getSize().y));
+    Affine T;
+    T.translate(view.getCenter()).rotate(view.getRotation());
+    return T.transformRect(FloatRect(-0.5f * size, size));
+}
 
 } // private namespace
 
@@ -306,6 +322,7 @@ void Engine::init(unsigned int width, unsigned int height, unsigned int style, c
     Input::detail::init();
     Debug::detail::init(); 
     Physics::detail::init();
+    Transforms::detail::init();
 
     // loaded
     g_initialized = true;
@@ -340,6 +357,9 @@ void Engine::renderThread() {
         // input update
         Input::detail::update();
         processEvents();
+        // run continuations jobs queued for this thread
+        if (g_jobs)
+            g_jobs->runMainThreadJobs();
         // update delta time
         auto deltaTime = g_clock.restart();
         g_delta = deltaTime.asSeconds();
@@ -360,11 +380,16 @@ void Engine::renderThread() {
             g_root->onPhysics();
             // update all objects
             g_root->updateAll();
+            GameObject::processCommands();
             // late update all object
             g_root->lateUpdateAll();
+            GameObject::processCommands();
             // increment frame
             g_frame++;
         }
+        // compute dirty world matrices and notify Transform listeners
+        Transforms::detail::update();
+        Transform::processChanges();
         // clear window
         window->clear(g_bgColor);
         // render
@@ -395,11 +420,14 @@ void Engine::run() {
     // free resources
     freeResources();
     // delete root GameObject
+    GameObject::processCommands();
     g_root.reset();
     // shutdown systems
+    g_jobs.reset();
     ImGui::SFML::Shutdown();
     Physics::detail::shutdown();
     Debug::detail::shutdown();
+    Transforms::detail::shutdown();
     g_initialized = false;   
 }
 
@@ -413,7 +441,25 @@ float Engine::time() {
 }
 
 float Engine::deltaTime() {
-    return g_delta;
+    return g_tickDelta >= 0.0f ? g_tickDelta : g_delta;
+}
+
+void Engine::setUpdateBudget(float milliseconds) {
+    g_budget = milliseconds;
+}
+
+float Engine::getUpdateBudget() {
+    return g_budget;
+}
+
+JobSystem& Engine::jobs() {
+    if (!g_jobs)
+        g_jobs = make<JobSystem>();
+    return *g_jobs;
+}
+
+void Engine::setTickDelta(float delta) {
+    g_tickDelta = delta;
 }
 
 std::size_t Engine::frame() {
@@ -466,24 +512,58 @@ Handle<GameObject> Engine::getRoot() {
 }
 
 void Engine::render() {
-    // clear each layer in the RenderQue and reserve capacity for max number of Objects
-    for (auto& layer : g_renderQue) {
+    // clear each layer in the RenderQue
+    for (auto& layer : g_renderQue)
         layer.clear();
-        layer.reserve(Renderer::getRendererCount());
-    }
-    // que Objects for rendering
+    // que Objects which override onRender; Renderers are found through the culling grid
     g_root->onRender(g_renderQue);
+    auto start = std::chrono::high_resolution_clock::now();
+    // move the Renderers which changed, with cells sized so that the largest
+    // view spans about eight cells
+    float viewSize = 0;
+    for (auto& view : g_views)
+        viewSize = std::max({viewSize, std::abs(view.getSize().x), std::abs(view.getSize().y)});
+    Renderer::updateCulling(viewSize / 8);
+    float cullingTime = 0;
+    std::size_t drawn = 0;
+    std::size_t culled = 0;
+    auto draw = [](const Renderer* renderer) {
+        if (!renderer->batch(g_renderBatch)) {
+            g_renderBatch.flush();
+            renderer->render(*window);
+        }
+    };
     // iterate over views
     for (auto& view : g_views) {
         // set view
         window->setView(view);
-        // iterate over layers and draw
-        for (auto& layer : g_renderQue) {
-            for (auto& renderer : layer) {
-                renderer->render(*window);
-            }
+        // find visible Renderers and sort them by layer, then tree order
+        g_visible.clear();
+        culled += Renderer::findVisible(visibleRect(view), g_visible);
+        std::sort(g_visible.begin(), g_visible.end(), [](const Renderer* a, const Renderer* b) {
+            return a->m_layer != b->m_layer ? a->m_layer < b->m_layer : a->m_drawOrder < b->m_drawOrder;
+        });
+        auto now = std::chrono::high_resolution_clock::now();
+        cullingTime += std::chrono::duration<float, std::milli>(now - start).count();
+        // draw, merging consecutive Renderers which share a texture, shader
+        // and blend mode into one draw call; Renderers qued by onRender follow
+        // the visible Renderers of their layer
+        g_renderBatch.begin(*window);
+        std::size_t next = 0;
+        for (std::size_t layer = 0; layer < g_renderQue.size(); ++layer) {
+            for (; next < g_visible.size() && g_visible[next]->m_layer <= layer; ++next)
+                draw(g_visible[next]);
+            for (auto renderer : g_renderQue[layer])
+                draw(renderer);
+            drawn += g_renderQue[layer].size();
         }
+        for (; next < g_visible.size(); ++next)
+            draw(g_visible[next]);
+        g_renderBatch.flush();
+        drawn += g_visible.size();
+        start = std::chrono::high_resolution_clock::now();
     }
+    Renderer::endFrame(drawn, culled, cullingTime);
 }
 
 void Engine::processEvents() {
@@ -3,12 +3,149 @@
 #include <Engine/Components/Transform.hpp>
 #include <Engine/GameObject.hpp>
 #include <Engine/Engine.hpp>
+#include <Engine/ComponentRegistry.hpp>
 #include <Engine/Coroutine.hpp>
+#include <Graphics/Components/Renderer.hpp>
+#include <Utility/DeferQueue.hpp>
 #include <algorithm>
 #include <cmath>
+#include <unordered_map>
+#include <chrono>
 
 namespace carnot {
 
+//==============================================================================
+// Tick Lists
+//==============================================================================
+
+namespace {
+
+/// Operation performed by an update tick
+enum UpdateOp : unsigned char {
+    StartGameObject,  ///< call start() on a GameObject
+    UpdateGameObject, ///< call update() and resume coroutines on a GameObject
+    UpdateComponent,  ///< call Component::updateAll()
+    UpdateParallel    ///< update the children of a GameObject concurrently
+};
+
+/// Entry in the update tick lists
+struct UpdateTick {
+    Object* object;
+    GameObject* owner; ///< the GameObject, or the GameObject of the Component
+    UpdateOp op;
+};
+
+/// Entry in the lateUpdate, physics, render and gizmo tick lists
+struct Tick {
+    Object* object;
+    GameObject* owner; ///< the GameObject, or the GameObject of the Component
+};
+
+/// Update ticks of the children of a parallel GameObject, one contiguous
+/// segment per child subtree
+struct ParallelGroup {
+    std::vector<UpdateTick>  ticks;
+    std::vector<std::size_t> segments;  ///< start of each child's ticks, then the end
+    bool                     dirty = true; ///< true if segments must be recomputed
+};
+
+/// Flat per-phase lists of the Objects which need each Engine callback, in
+/// the order a depth first traversal of the tree would visit them. Changes
+/// splice the affected GameObject's entries, or its subtree's contiguous
+/// range, in or out. Ranges are found by binary search, comparing the
+/// sibling indices of the owners' ancestors (see GameObject::compareTicks).
+struct TickLists {
+    GameObject*             root    = nullptr; ///< root the lists were built from
+    bool                    ticking = false;   ///< true while a list is being iterated
+    std::vector<UpdateTick> update;
+    std::vector<UpdateTick> lowUpdate;         ///< Low priority updates, run within the update budget
+    std::size_t             lowCursor = 0;     ///< next Low priority update to run
+    std::vector<Tick>       lateUpdate;
+    std::vector<Tick>       physics;
+    std::vector<Tick>       render;
+    std::vector<Tick>       gizmo;
+    std::vector<Tick>       renderers;         ///< enabled Renderers, whose draw order is their index
+    std::size_t             renumberFrom = 0;  ///< first entry of renderers whose index may have changed
+    std::unordered_map<const GameObject*, ParallelGroup> groups; ///< children of parallel GameObjects
+    std::vector<GameObject*> pending;          ///< GameObjects queued by refreshTicks
+    bool                    started = false;   ///< true if update entries may only be left for start()
+};
+
+TickLists g_ticks;
+
+/// Flags of GameObject::m_tickRefresh
+enum TickRefresh : unsigned char {
+    RefreshLocal   = 1 << 0, ///< update the GameObject's own entries
+    RefreshSubtree = 1 << 1  ///< update the entries of the whole subtree
+};
+
+/// Returns the list holding the update ticks of the children of group
+std::vector<UpdateTick>& updateList(const GameObject* group) {
+    return group ? g_ticks.groups[group].ticks : g_ticks.update;
+}
+
+/// Returns the range of entries whose owner is in the subtree of target
+/// (or is target itself if !subtree), given owner comparisons to target
+template <typename T, typename Compare>
+std::pair<std::size_t, std::size_t> findTicks(const std::vector<T>& list, const GameObject* target, bool subtree, Compare compare) {
+    auto begin = std::partition_point(list.begin(), list.end(), [&](const T& tick) { return compare(tick.owner) < 0; });
+    // a GameObject's own entries come before those of its descendants
+    auto end = subtree ? std::partition_point(begin, list.end(), [&](const T& tick) { return compare(tick.owner) == 0; })
+                       : std::find_if(begin, list.end(), [&](const T& tick) { return tick.owner != target; });
+    return { begin - list.begin(), end - list.begin() };
+}
+
+/// Inserts a batch of entries where the subtree of the owner compared lies
+template <typename T, typename Compare>
+std::size_t insertTicks(std::vector<T>& list, const std::vector<T>& batch, Compare compare) {
+    if (batch.empty())
+        return list.size();
+    auto it = std::partition_point(list.begin(), list.end(), [&](const T& tick) { return compare(tick.owner) < 0; });
+    std::size_t index = it - list.begin();
+    list.insert(it, batch.begin(), batch.end());
+    return index;
+}
+
+/// Removes a range of entries
+template <typename T>
+void eraseTicks(std::vector<T>& list, std::pair<std::size_t, std::size_t> range) {
+    list.erase(list.begin() + range.first, list.begin() + range.second);
+}
+
+} // private namespace
+
+/// Entries of a GameObject, or of its subtree, in depth first order
+struct GameObject::TickBatch {
+    std::vector<UpdateTick>  update;       ///< Normal priority updates of the GameObject's list
+    std::vector<UpdateTick>* target = &update; ///< list Normal priority updates are collected into
+    std::vector<UpdateTick>  lowUpdate;
+    std::vector<Tick>        lateUpdate;
+    std::vector<Tick>        physics;
+    std::vector<Tick>        render;
+    std::vector<Tick>        gizmo;
+    std::vector<Tick>        renderers;
+};
+
+//==============================================================================
+// Structural Command Buffer
+//==============================================================================
+
+/// A deferred structural change to a GameObject
+struct GameObject::Command {
+    enum Type : unsigned char {
+        AttachChild,
+        DestroyChild,
+        AttachComponent,
+        RemoveComponent,
+        MakeChildFirst,
+        MakeChildLast
+    };
+    Type type;                 ///< type of change
+    Handle<GameObject> target; ///< GameObject whose children/Components change
+    Ptr<Object> added;         ///< child or Component to attach
+    Handle<Object> removed;    ///< child or Component to remove (or child to move)
+};
+
 GameObject::GameObject(const Name& name) :
     Object(name),
     m_iteratingChildren(false),
@@ -17,7 +154,14 @@ GameObject::GameObject(const Name& name) :
     m_parent(nullptr),
     m_index(0),
     m_isRoot(false),
-    transform(*attachComponent(std::make_shared<Transform>(*this)).as<Transform>().get())
+    m_despawned(false),
+    m_parallelChildren(false),
+    m_listed(false),
+    m_tickRefresh(0),
+    m_tickParent(nullptr),
+    m_tickIndex(0),
+    m_tickGroup(nullptr),
+    transform(*static_cast<Transform*>(attachComponent(makeObject<Transform>(*this)).get()))
 { }
 
 GameObject::GameObject() :
@@ -28,9 +172,29 @@ GameObject::GameObject() :
     m_parent(nullptr),
     m_index(0),
     m_isRoot(false),
-    transform(*attachComponent(std::make_shared<Transform>(*this)).as<Transform>().get())
+    m_despawned(false),
+    m_parallelChildren(false),
+    m_listed(false),
+    m_tickRefresh(0),
+    m_tickParent(nullptr),
+    m_tickIndex(0),
+    m_tickGroup(nullptr),
+    transform(*static_cast<Transform*>(attachComponent(makeObject<Transform>(*this)).get()))
 { }
 
+GameObject::~GameObject() {
+    // only the root is destroyed while listed, its descendants follow
+    if (m_listed)
+        unlistTicks(true);
+    if (m_tickRefresh != 0)
+        g_ticks.pending.erase(std::remove(g_ticks.pending.begin(), g_ticks.pending.end(), this), g_ticks.pending.end());
+    if (g_ticks.root == this)
+        g_ticks.root = nullptr;
+    // destroy Components in reverse, so that the Transform outlives the rest
+    while (!m_components.empty())
+        m_components.pop_back();
+}
+
 //==============================================================================
 // General
 //==============================================================================
@@ -58,6 +222,24 @@ bool GameObject::isRoot() const {
     return m_isRoot;
 }
 
+void GameObject::setParallelChildren(bool parallel) {
+    if (parallel != m_parallelChildren) {
+        m_parallelChildren = parallel;
+        refreshTicks(true);
+    }
+}
+
+bool GameObject::hasParallelChildren() const {
+    return m_parallelChildren;
+}
+
+void GameObject::defer(std::function<void()> fn) {
+    if (auto queue = detail::deferQueue())
+        queue->push_back(std::move(fn));
+    else
+        fn();
+}
+
 //==============================================================================
 // Children
 //==============================================================================
@@ -67,29 +249,48 @@ std::size_t GameObject::getChildCount() const {
 }
 
 void GameObject::attachChild(Ptr<GameObject> gameObject) {
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self, gameObject]() { if (self) self->attachChild(gameObject); });
+        return;
+    }
     gameObject->m_parent = this;
-    if (!m_iteratingChildren) {
+    gameObject->transform.updateParent();
+    if (!m_iteratingChildren && !isTicking()) {
+        GameObject* child = gameObject.get();
+        child->m_index = m_children.size();
         m_children.push_back(std::move(gameObject));
-        updateChildIndices();
+        m_childLookup.clear();
+        if (m_listed)
+            child->updateTicks(true);
     }
     else {
-        m_childrenAdd.push_back(std::move(gameObject));
+        commands().push_back({Command::AttachChild, Handle<GameObject>(this), std::move(gameObject), Handle<Object>()});
     }
 }
 
 Ptr<GameObject> GameObject::detachChild(std::size_t index) {
     assert(index < m_children.size());
-    if (!m_iteratingChildren) {
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self, index]() { if (self) self->detachChild(index); });
+        return m_children[index];
+    }
+    if (!m_iteratingChildren && !isTicking()) {
         // children are not being iterated, so detach child now
         Ptr<GameObject> obj = std::move(m_children[index]);
+        if (obj->m_listed && obj->m_tickParent == this)
+            obj->unlistTicks(true);
         m_children.erase(m_children.begin() + index);
         obj->m_parent = nullptr;
+        obj->transform.updateParent();
         updateChildIndices();
         return obj;
     }
     else {
         // children are being iterated, so defer removal until later
         m_children[index]->m_parent = nullptr;
+        m_children[index]->transform.updateParent();
         destroyChild(index);
         return m_children[index];
     }
@@ -97,12 +298,22 @@ Ptr<GameObject> GameObject::detachChild(std::size_t index) {
 
 void GameObject::destroyChild(std::size_t index) {
     assert(index < m_children.size());
-    m_childrenDel.push_back(m_children[index].get());
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self, index]() { if (self) self->destroyChild(index); });
+        return;
+    }
+    commands().push_back({Command::DestroyChild, Handle<GameObject>(this), nullptr, Handle<Object>(m_children[index].get())});
 }
 
 void GameObject::destroyChildren() {
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self]() { if (self) self->destroyChildren(); });
+        return;
+    }
     for (auto& child : m_children)
-        m_childrenDel.push_back(child.get());
+        commands().push_back({Command::DestroyChild, Handle<GameObject>(this), nullptr, Handle<Object>(child.get())});
 }
 
 Handle<GameObject> GameObject::getChild(std::size_t index) {
@@ -111,21 +322,51 @@ Handle<GameObject> GameObject::getChild(std::size_t index) {
 }
 
 void GameObject::makeChildFirst(std::size_t index) {
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self, index]() { if (self) self->makeChildFirst(index); });
+        return;
+    }
     assert(!m_iteratingChildren);
     assert(index < m_children.size());
+    if (isTicking()) {
+        // the tick lists are in child order, so reorder once they aren't iterated
+        commands().push_back({Command::MakeChildFirst, Handle<GameObject>(this), nullptr, Handle<Object>(m_children[index].get())});
+        return;
+    }
+    GameObject* child = m_children[index].get();
+    if (child->m_listed && child->m_tickParent == this)
+        child->unlistTicks(true);
     Ptr<GameObject> obj = std::move(m_children[index]);
     m_children.erase(m_children.begin() + index);
     m_children.insert(m_children.begin(), std::move(obj));
     updateChildIndices();
+    if (m_listed)
+        child->updateTicks(true);
 }
 
 void GameObject::makeChildLast(std::size_t index) {
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self, index]() { if (self) self->makeChildLast(index); });
+        return;
+    }
     assert(!m_iteratingChildren);
     assert(index < m_children.size());
+    if (isTicking()) {
+        // the tick lists are in child order, so reorder once they aren't iterated
+        commands().push_back({Command::MakeChildLast, Handle<GameObject>(this), nullptr, Handle<Object>(m_children[index].get())});
+        return;
+    }
+    GameObject* child = m_children[index].get();
+    if (child->m_listed && child->m_tickParent == this)
+        child->unlistTicks(true);
     Ptr<GameObject> obj = std::move(m_children[index]);
     m_children.erase(m_children.begin() + index);
     m_children.push_back(std::move(obj));
     updateChildIndices();
+    if (m_listed)
+        child->updateTicks(true);
 }
 
 Handle<GameObject> GameObject::findChild(Id id) {
@@ -195,13 +436,26 @@ bool GameObject::isSiblingOf(Handle<GameObject> object) {
 void GameObject::updateComponentIndices() {
     for (std::size_t i = 0; i < m_components.size(); ++i)
         m_components[i]->m_index = i;
+    m_componentLookup.clear();
 }
 
-void GameObject::updateComponents() {
-    m_iteratingComponents = true;
-    for (const auto& comp : m_components)
-        comp->updateAll();
-    m_iteratingComponents = false;
+std::size_t GameObject::findComponentIndex(TypeId query, bool(*isA)(const Object*)) const {
+    if (query < m_componentLookup.size() && m_componentLookup[query] != 0)
+        return m_componentLookup[query] - 1;
+    std::size_t first = npos;
+    for (std::size_t i = 0; i < m_components.size(); ++i) {
+        if (isA(m_components[i].get())) {
+            first = i;
+            break;
+        }
+    }
+    // other threads may be reading the cache during a parallel update
+    if (!detail::isDeferring()) {
+        if (query >= m_componentLookup.size())
+            m_componentLookup.resize(query + 1, 0);
+        m_componentLookup[query] = first + 1;
+    }
+    return first;
 }
 
 std::size_t GameObject::getComponentCount() const {
@@ -210,30 +464,49 @@ std::size_t GameObject::getComponentCount() const {
 
 void GameObject::removeComponent(std::size_t index) {
     assert (index < m_components.size());
-    if (!m_iteratingComponents) {
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self, index]() { if (self) self->removeComponent(index); });
+        return;
+    }
+    if (!m_iteratingComponents && !isTicking()) {
+        // the Component's entries go before it does
+        if (m_listed)
+            unlistTicks(false);
         auto component = m_components.begin() + index;
         auto h = Handle<Component>(*component);
         for (auto& other : m_components) {
             other->onComponentRemoved(h);
         }
+        detail::ComponentRegistry::remove(component->get());
         m_components.erase(component);
         updateComponentIndices();
+        if (m_listed)
+            listTicks(false);
     }
     else {
-        m_componentsDel.push_back(m_components[index].get());
+        commands().push_back({Command::RemoveComponent, Handle<GameObject>(this), nullptr, Handle<Object>(m_components[index].get())});
     }
 }
 
 Handle<Component> GameObject::attachComponent(Ptr<Component> component) {
     auto h = Handle<Component>(component);
-    if (!m_iteratingComponents) {
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self, component]() { if (self) self->attachComponent(component); });
+        return h;
+    }
+    if (!m_iteratingComponents && !isTicking()) {
+        detail::ComponentRegistry::add(component.get());
+        component->m_index = m_components.size();
         m_components.push_back(std::move(component));
-        updateComponentIndices();
+        m_componentLookup.clear();
         for (auto& other : m_components)
             other->onComponentAdded(h);
+        refreshTicks(false);
     }
     else {
-        m_componentsAdd.push_back(std::move(component));
+        commands().push_back({Command::AttachComponent, Handle<GameObject>(this), std::move(component), Handle<Object>()});
     }
     return h;
 }
@@ -243,125 +516,663 @@ Handle<Component> GameObject::attachComponent(Ptr<Component> component) {
 //==============================================================================
 
 void GameObject::updateChildIndices() {
-    for (std::size_t i = 0; i < m_children.size(); ++i)
+    for (std::size_t i = 0; i < m_children.size(); ++i) {
         m_children[i]->m_index = i;
+        // listed children keep their relative order, so their entries stay sorted
+        if (m_children[i]->m_listed && m_children[i]->m_tickParent == this)
+            m_children[i]->m_tickIndex = i;
+    }
+    m_childLookup.clear();
+}
+
+std::size_t GameObject::findChildIndex(TypeId query, bool(*isA)(const Object*)) const {
+    return lookupChildren(query, isA).first;
+}
+
+std::size_t GameObject::countChildren(TypeId query, bool(*isA)(const Object*)) const {
+    return lookupChildren(query, isA).count;
+}
+
+GameObject::ChildLookup GameObject::lookupChildren(TypeId query, bool(*isA)(const Object*)) const {
+    if (query < m_childLookup.size() && m_childLookup[query].count != npos)
+        return m_childLookup[query];
+    ChildLookup lookup;
+    lookup.count = 0;
+    for (std::size_t i = 0; i < m_children.size(); ++i) {
+        if (isA(m_children[i].get())) {
+            if (lookup.count++ == 0)
+                lookup.first = i;
+        }
+    }
+    // other threads may be reading the cache during a parallel update
+    if (!detail::isDeferring()) {
+        if (query >= m_childLookup.size())
+            m_childLookup.resize(query + 1);
+        m_childLookup[query] = lookup;
+    }
+    return lookup;
+}
+
+
+void GameObject::applyCommands(Command* begin, Command* end) {
+    std::vector<GameObject*> attached;
+    std::vector<Handle<Component>> added;
+    std::vector<Object*> removedChildren;
+    std::vector<Object*> removedComponents;
+    std::vector<Command*> moved;
+    // additions first, so that objects added and destroyed in the same frame are removed
+    for (Command* it = begin; it != end; ++it) {
+        if (it->type == Command::AttachChild) {
+            auto child = std::static_pointer_cast<GameObject>(std::move(it->added));
+            child->m_index = m_children.size();
+            attached.push_back(child.get());
+            m_children.push_back(std::move(child));
+        }
+        else if (it->type == Command::AttachComponent) {
+            auto component = std::static_pointer_cast<Component>(std::move(it->added));
+            detail::ComponentRegistry::add(component.get());
+            component->m_index = m_components.size();
+            added.push_back(Handle<Component>(component));
+            m_components.push_back(std::move(component));
+        }
+        else if (it->type == Command::DestroyChild) {
+            if (it->removed.isValid())
+                removedChildren.push_back(it->removed.get());
+        }
+        else if (it->type == Command::RemoveComponent) {
+            if (it->removed.isValid())
+                removedComponents.push_back(it->removed.get());
+        }
+        else {
+            moved.push_back(it);
+        }
+    }
+    // this GameObject's own entries are relisted once its Components are final
+    bool relist = m_listed && (!added.empty() || !removedComponents.empty());
+    if (relist)
+        unlistTicks(false);
+    // changes made by callbacks are queued for the next batch
+    m_iteratingComponents = true;
+    for (auto& h : added) {
+        for (std::size_t i = 0; i < m_components.size(); ++i)
+            m_components[i]->onComponentAdded(h);
+    }
+    m_iteratingComponents = false;
+    // removals are compacted in a single pass per list
+    std::vector<Ptr<Object>> graveyard; // keeps removed objects alive until indices are fixed
+    if (!removedComponents.empty()) {
+        std::sort(removedComponents.begin(), removedComponents.end());
+        m_iteratingComponents = true;
+        for (auto& component : m_components) {
+            if (std::binary_search(removedComponents.begin(), removedComponents.end(), component.get())) {
+                auto h = Handle<Component>(component);
+                for (auto& other : m_components)
+                    other->onComponentRemoved(h);
+            }
+        }
+        m_iteratingComponents = false;
+        auto last = std::stable_partition(m_components.begin(), m_components.end(), [&](const Ptr<Component>& component) {
+            return !std::binary_search(removedComponents.begin(), removedComponents.end(), component.get());
+        });
+        for (auto it = last; it != m_components.end(); ++it) {
+            detail::ComponentRegistry::remove(it->get());
+            graveyard.push_back(std::move(*it));
+        }
+        m_components.erase(last, m_components.end());
+    }
+    if (!removedChildren.empty()) {
+        std::sort(removedChildren.begin(), removedChildren.end());
+        auto last = std::stable_partition(m_children.begin(), m_children.end(), [&](const Ptr<GameObject>& child) {
+            return !std::binary_search(removedChildren.begin(), removedChildren.end(), child.get());
+        });
+        for (auto it = last; it != m_children.end(); ++it) {
+            // children detached and reattached elsewhere keep their new parent and entries
+            if ((*it)->m_listed && (*it)->m_tickParent == this)
+                (*it)->unlistTicks(true);
+            if ((*it)->m_parent == this) {
+                (*it)->m_parent = nullptr;
+                (*it)->transform.updateParent();
+            }
+            graveyard.push_back(std::move(*it));
+        }
+        m_children.erase(last, m_children.end());
+    }
+    // single index fix-up (appends already have correct indices)
+    if (!removedChildren.empty())
+        updateChildIndices();
+    else
+        m_childLookup.clear();
+    if (!removedComponents.empty())
+        updateComponentIndices();
+    else
+        m_componentLookup.clear();
+    // new children are spliced into the tick lists once their indices are final
+    if (m_listed) {
+        for (auto child : attached) {
+            if (child->m_parent == this && child->m_index < m_children.size() && m_children[child->m_index].get() == child)
+                child->updateTicks(true);
+        }
+    }
+    if (relist)
+        listTicks(false);
+    // reorders last, since they move a child's entries
+    for (auto it : moved) {
+        auto child = static_cast<GameObject*>(it->removed.get());
+        if (child == nullptr || child->m_index >= m_children.size() || m_children[child->m_index].get() != child)
+            continue;
+        if (it->type == Command::MakeChildFirst)
+            makeChildFirst(child->m_index);
+        else
+            makeChildLast(child->m_index);
+    }
 }
 
-void GameObject::updateChildren() {
+std::vector<GameObject::Command>& GameObject::commands() {
+    static std::vector<Command> s_commands;
+    return s_commands;
+}
+
+void GameObject::processCommands() {
+    while (!commands().empty()) {
+        // take the queue, since callbacks may queue further changes
+        std::vector<Command> queued;
+        queued.swap(commands());
+        // group by target in order of first appearance, preserving issue order within groups
+        std::unordered_map<GameObject*, std::size_t> groups;
+        std::vector<std::size_t> order(queued.size());
+        for (std::size_t i = 0; i < queued.size(); ++i)
+            order[i] = groups.emplace(queued[i].target.get(), groups.size()).first->second;
+        std::vector<std::size_t> perm(queued.size());
+        for (std::size_t i = 0; i < perm.size(); ++i)
+            perm[i] = i;
+        std::stable_sort(perm.begin(), perm.end(), [&](std::size_t a, std::size_t b) { return order[a] < order[b]; });
+        std::vector<Command> sorted;
+        sorted.reserve(queued.size());
+        for (auto i : perm)
+            sorted.push_back(std::move(queued[i]));
+        // apply each group with a single index fix-up
+        Command* begin = sorted.data();
+        Command* last = sorted.data() + sorted.size();
+        while (begin != last) {
+            Command* end = begin;
+            GameObject* target = begin->target.get();
+            while (end != last && end->target.get() == target)
+                ++end;
+            if (target != nullptr)
+                target->applyCommands(begin, end);
+            begin = end;
+        }
+    }
+}
+
+void GameObject::spawnAll() {
+    m_iteratingComponents = true;
+    for (const auto& comp : m_components)
+        comp->onSpawn();
+    m_iteratingComponents = false;
+    onSpawn();
+    m_iteratingChildren = true;
+    for (const auto& child : m_children)
+        child->spawnAll();
+    m_iteratingChildren = false;
+}
+
+void GameObject::despawnAll() {
+    m_iteratingComponents = true;
+    for (const auto& comp : m_components) {
+        comp->stopAllCoroutines();
+        comp->onDespawn();
+    }
+    m_iteratingComponents = false;
+    stopAllCoroutines();
+    onDespawn();
     m_iteratingChildren = true;
     for (const auto& child : m_children)
-        child->updateAll();
+        child->despawnAll();
     m_iteratingChildren = false;
 }
 
-void GameObject::processAdditions() {
-    // process children
-    while (!m_childrenAdd.empty()) {
-        attachChild(std::move(m_childrenAdd.back()));
-        m_childrenAdd.pop_back();
+bool GameObject::isTicking() const {
+    // queued, detached and disabled GameObjects aren't reached by the lists
+    return g_ticks.ticking && m_listed;
+}
+
+void GameObject::buildTicks() {
+    if (g_ticks.root != this) {
+        assert(g_ticks.root == nullptr || !g_ticks.root->m_listed);
+        g_ticks.root = this;
+        updateTicks(true);
     }
-    // process Components
-    while (!m_componentsAdd.empty()) {
-        attachComponent(std::move(m_componentsAdd.back()));
-        m_componentsAdd.pop_back();
+    // apply the changes queued since the lists were last iterated
+    for (std::size_t i = 0; i < g_ticks.pending.size(); ++i) {
+        GameObject* object = g_ticks.pending[i];
+        bool subtree = (object->m_tickRefresh & RefreshSubtree) != 0;
+        object->m_tickRefresh = 0;
+        object->updateTicks(subtree);
     }
+    g_ticks.pending.clear();
 }
 
-void GameObject::processDeletions() {
-    // process children
-    while (!m_childrenDel.empty()) {
-        detachChild(m_childrenDel.back()->getIndex());
-        m_childrenDel.pop_back();
+void GameObject::collectTicks(TickBatch& batch, bool subtree) {
+    auto& update = *batch.target;
+    if (!m_startCalled)
+        update.push_back({this, this, StartGameObject});
+    for (const auto& comp : m_components) {
+        if (comp->isEnabled() && (!comp->m_startCalled || (comp->m_ticks & TickUpdate) || comp->hasCoroutines())) {
+            auto& list = comp->getUpdatePriority() == UpdatePriority::Low ? batch.lowUpdate : update;
+            list.push_back({comp.get(), this, UpdateComponent});
+        }
+        if (comp->m_ticks & TickLateUpdate)
+            batch.lateUpdate.push_back({comp.get(), this});
+        if (comp->m_ticks & TickPhysics)
+            batch.physics.push_back({comp.get(), this});
+        if (comp->m_ticks & TickRender)
+            batch.render.push_back({comp.get(), this});
+        if (comp->isEnabled() && (comp->m_ticks & TickGizmo))
+            batch.gizmo.push_back({comp.get(), this});
+        if (comp->isEnabled() && detail::isA<Renderer>(comp.get()))
+            batch.renderers.push_back({comp.get(), this});
+    }
+    if ((m_ticks & TickUpdate) || hasCoroutines()) {
+        auto& list = getUpdatePriority() == UpdatePriority::Low ? batch.lowUpdate : update;
+        list.push_back({this, this, UpdateGameObject});
     }
-    // process Components
-    while (!m_componentsDel.empty()) {
-        removeComponent(m_componentsDel.back()->getIndex());
-        m_componentsDel.pop_back();
+    if (m_ticks & TickLateUpdate)
+        batch.lateUpdate.push_back({this, this});
+    // parallel GameObjects nested in a parallel subtree update serially within it
+    GameObject* group = m_tickParent ? m_tickParent->m_tickGroup : nullptr;
+    if (!subtree) {
+        if (m_tickGroup == this)
+            update.push_back({this, this, UpdateParallel});
+        return;
     }
+    m_tickGroup = group;
+    if (m_parallelChildren && group == nullptr) {
+        update.push_back({this, this, UpdateParallel});
+        m_tickGroup = this;
+        auto& children = g_ticks.groups[this];
+        children.ticks.clear();
+        children.dirty = true;
+        batch.target = &children.ticks;
+    }
+    for (const auto& child : m_children) {
+        // children detached while the lists were iterated are removed with the commands
+        if (child->m_parent != this || !child->isEnabled())
+            continue;
+        // as are children which were reattached elsewhere meanwhile
+        if (child->m_listed)
+            child->unlistTicks(true);
+        child->m_listed = true;
+        child->m_tickParent = this;
+        child->m_tickIndex = child->m_index;
+        child->collectTicks(batch, true);
+    }
+    batch.target = &update;
 }
 
-void GameObject::updateAll() {
-    processAdditions();
-    if (isEnabled()) {
-        if (!m_startCalled) {
-            start();
-            m_startCalled = true;
+void GameObject::listTicks(bool subtree) {
+    assert(!g_ticks.ticking);
+    if (subtree) {
+        assert(!m_listed);
+        // only enabled GameObjects held by a listed parent are listed
+        if (!isEnabled())
+            return;
+        if (this == g_ticks.root) {
+            m_tickParent = nullptr;
+            m_tickIndex = 0;
+        }
+        else if (m_parent && m_parent->m_listed && m_index < m_parent->m_children.size() && m_parent->m_children[m_index].get() == this) {
+            m_tickParent = m_parent;
+            m_tickIndex = m_index;
+        }
+        else {
+            return;
         }
-        updateComponents();
-        update();
-        if (hasCoroutines())
-            resumeCoroutines();
-        updateChildren();
+        m_listed = true;
     }
-    processDeletions();
+    else if (!m_listed) {
+        return;
+    }
+    TickBatch batch;
+    collectTicks(batch, subtree);
+    std::size_t depth = getTickDepth();
+    auto compare = [this, depth](const GameObject* owner) { return compareTicks(owner, this, depth); };
+    GameObject* group = m_tickParent ? m_tickParent->m_tickGroup : nullptr;
+    insertTicks(updateList(group), batch.update, compare);
+    if (group)
+        g_ticks.groups[group].dirty = true;
+    std::size_t low = insertTicks(g_ticks.lowUpdate, batch.lowUpdate, compare);
+    if (low < g_ticks.lowCursor)
+        g_ticks.lowCursor += batch.lowUpdate.size();
+    insertTicks(g_ticks.lateUpdate, batch.lateUpdate, compare);
+    insertTicks(g_ticks.physics, batch.physics, compare);
+    insertTicks(g_ticks.render, batch.render, compare);
+    insertTicks(g_ticks.gizmo, batch.gizmo, compare);
+    // Renderers are culled through a grid rather than visited every frame
+    std::size_t first = insertTicks(g_ticks.renderers, batch.renderers, compare);
+    g_ticks.renumberFrom = std::min(g_ticks.renumberFrom, first);
+    for (auto& tick : batch.renderers)
+        static_cast<Renderer*>(tick.object)->setListed(true);
 }
 
-void GameObject::lateUpdateAll() {
-    processAdditions();
-    if (isEnabled()) {
-        // update components
-        m_iteratingComponents = true;
-        for (const auto& comp : m_components)
-            comp->lateUpdate();
-        m_iteratingComponents = false;
-        // update self
-        lateUpdate();
-        // update children
-        m_iteratingChildren = true;
-        for (const auto& child : m_children)
-            child->lateUpdateAll();
-        m_iteratingChildren = false;
+void GameObject::unlistTicks(bool subtree) {
+    assert(!g_ticks.ticking);
+    if (!m_listed)
+        return;
+    std::size_t depth = getTickDepth();
+    auto compare = [this, depth](const GameObject* owner) { return compareTicks(owner, this, depth); };
+    GameObject* group = m_tickParent ? m_tickParent->m_tickGroup : nullptr;
+    auto& update = updateList(group);
+    auto range = findTicks(update, this, subtree, compare);
+    if (subtree) {
+        // groups of parallel GameObjects leave with them
+        for (std::size_t i = range.first; i < range.second; ++i) {
+            if (update[i].op == UpdateParallel)
+                g_ticks.groups.erase(update[i].owner);
+        }
+    }
+    eraseTicks(update, range);
+    if (group)
+        g_ticks.groups[group].dirty = true;
+    range = findTicks(g_ticks.lowUpdate, this, subtree, compare);
+    eraseTicks(g_ticks.lowUpdate, range);
+    if (g_ticks.lowCursor >= range.second)
+        g_ticks.lowCursor -= range.second - range.first;
+    else if (g_ticks.lowCursor > range.first)
+        g_ticks.lowCursor = range.first;
+    eraseTicks(g_ticks.lateUpdate, findTicks(g_ticks.lateUpdate, this, subtree, compare));
+    eraseTicks(g_ticks.physics, findTicks(g_ticks.physics, this, subtree, compare));
+    eraseTicks(g_ticks.render, findTicks(g_ticks.render, this, subtree, compare));
+    eraseTicks(g_ticks.gizmo, findTicks(g_ticks.gizmo, this, subtree, compare));
+    range = findTicks(g_ticks.renderers, this, subtree, compare);
+    for (std::size_t i = range.first; i < range.second; ++i)
+        static_cast<Renderer*>(g_ticks.renderers[i].object)->setListed(false);
+    eraseTicks(g_ticks.renderers, range);
+    g_ticks.renumberFrom = std::min(g_ticks.renumberFrom, range.first);
+    if (!subtree)
+        return;
+    // clear the listed flags of the subtree
+    std::vector<GameObject*> stack(1, this);
+    while (!stack.empty()) {
+        GameObject* object = stack.back();
+        stack.pop_back();
+        object->m_listed = false;
+        for (const auto& child : object->m_children) {
+            if (child->m_listed && child->m_tickParent == object)
+                stack.push_back(child.get());
+        }
     }
-    processDeletions();
 }
 
-void GameObject::onRender(RenderQue& que) {
-    if (isEnabled()) {
-        // que components
-        m_iteratingComponents = true;
-        for (const auto& comp : m_components)
-            comp->onRender(que);
-        m_iteratingComponents = false;
-        // que children
-        m_iteratingChildren = true;
-        for (const auto& child : m_children)
-            child->onRender(que);
-        m_iteratingChildren = false;
+void GameObject::updateTicks(bool subtree) {
+    if (subtree) {
+        unlistTicks(true);
+        listTicks(true);
+    }
+    else if (m_listed) {
+        unlistTicks(false);
+        listTicks(false);
     }
 }
 
-void GameObject::onGizmo() {
-    if (isEnabled()) {
-        // que components
-        m_iteratingComponents = true;
-        for (const auto& comp : m_components) {
-            if (comp->isEnabled() && comp->showGizmos)
-                comp->onGizmo();
+void GameObject::refreshTicks(bool subtree) {
+    if (detail::isDeferring()) {
+        Handle<GameObject> self(this);
+        defer([self, subtree]() { if (self) self->refreshTicks(subtree); });
+        return;
+    }
+    // GameObjects outside the lists only matter when (re)enabled under a listed parent
+    if (!m_listed && !(subtree && m_parent && m_parent->m_listed))
+        return;
+    if (m_tickRefresh == 0)
+        g_ticks.pending.push_back(this);
+    m_tickRefresh |= subtree ? RefreshSubtree : RefreshLocal;
+}
+
+void GameObject::pruneTicks() {
+    // dropping entries one GameObject at a time would splice the lists once
+    // per started Object, which is quadratic when many spawn together
+    g_ticks.started = false;
+    auto spent = [](const UpdateTick& tick) {
+        if (tick.op == StartGameObject)
+            return static_cast<GameObject*>(tick.object)->m_startCalled;
+        if (tick.op != UpdateComponent)
+            return false;
+        auto comp = static_cast<Component*>(tick.object);
+        return comp->m_startCalled && !(comp->m_ticks & TickUpdate) && !comp->hasCoroutines();
+    };
+    auto prune = [&](std::vector<UpdateTick>& list) {
+        auto end = std::remove_if(list.begin(), list.end(), spent);
+        bool removed = end != list.end();
+        list.erase(end, list.end());
+        return removed;
+    };
+    prune(g_ticks.update);
+    for (auto& entry : g_ticks.groups) {
+        if (prune(entry.second.ticks))
+            entry.second.dirty = true;
+    }
+    // keep the Low priority cursor on the entry it pointed to
+    auto& low = g_ticks.lowUpdate;
+    std::size_t cursor = 0;
+    for (std::size_t i = 0; i < g_ticks.lowCursor && i < low.size(); ++i) {
+        if (!spent(low[i]))
+            cursor++;
+    }
+    prune(low);
+    g_ticks.lowCursor = low.empty() ? 0 : cursor % low.size();
+}
+
+void GameObject::validateTransforms() const {
+    auto& store = Transforms::detail::store();
+    store.validate(transform.m_slot);
+    // parents before children, so each only needs its own matrices checked
+    std::vector<const GameObject*> stack(1, this);
+    while (!stack.empty()) {
+        const GameObject* object = stack.back();
+        stack.pop_back();
+        for (const auto& child : object->m_children) {
+            store.validateFromParent(child->transform.m_slot);
+            stack.push_back(child.get());
         }
-        m_iteratingComponents = false;
-        // que children
-        m_iteratingChildren = true;
-        for (const auto& child : m_children)
-            child->onGizmo();
-        m_iteratingChildren = false;
     }
 }
 
-void GameObject::onPhysics() {
-    if (isEnabled()) {
-        // que components
-        m_iteratingComponents = true;
-        for (const auto& comp : m_components)
-            comp->onPhysics();
-        m_iteratingComponents = false;
-        // que children
-        m_iteratingChildren = true;
-        for (const auto& child : m_children)
-            child->onPhysics();
-        m_iteratingChildren = false;
+std::size_t GameObject::getTickDepth() const {
+    std::size_t depth = 0;
+    for (const GameObject* object = m_tickParent; object != nullptr; object = object->m_tickParent)
+        depth++;
+    return depth;
+}
+
+int GameObject::compareTicks(const GameObject* owner, const GameObject* target, std::size_t depth) {
+    std::size_t ownerDepth = owner->getTickDepth();
+    const GameObject* a = owner;
+    const GameObject* b = target;
+    for (std::size_t d = ownerDepth; d > depth; --d)
+        a = a->m_tickParent;
+    if (a == b)
+        return 0;
+    // the entries of an ancestor come before those of its descendants
+    for (std::size_t d = depth; d > ownerDepth; --d)
+        b = b->m_tickParent;
+    if (a == b)
+        return -1;
+    while (a->m_tickParent != b->m_tickParent) {
+        a = a->m_tickParent;
+        b = b->m_tickParent;
+    }
+    return a->m_tickIndex < b->m_tickIndex ? -1 : 1;
+}
+
+void GameObject::updateAll() {
+    buildTicks();
+    // lists are only rebuilt between phases; structural changes are deferred meanwhile
+    g_ticks.ticking = true;
+    auto run = [](const UpdateTick& tick) {
+        if (tick.op == StartGameObject) {
+            auto gameObject = static_cast<GameObject*>(tick.object);
+            if (!gameObject->m_startCalled) {
+                gameObject->start();
+                gameObject->m_startCalled = true;
+                // the start entry is dropped by pruneTicks
+                g_ticks.started = true;
+            }
+            return;
+        }
+        Object* object = tick.object;
+        if (object->m_schedule) {
+            // throttled Objects see the time since their own last update
+            bool started = tick.op == UpdateGameObject || static_cast<Component*>(object)->m_startCalled;
+            if (started && !object->isUpdateDue())
+                return;
+            float now = Engine::time();
+            float last = object->m_schedule->lastTime;
+            Engine::setTickDelta(last >= 0.0f ? now - last : Engine::deltaTime());
+            object->m_schedule->lastTime = now;
+        }
+        if (tick.op == UpdateComponent) {
+            auto comp = static_cast<Component*>(object);
+            bool starting = !comp->m_startCalled;
+            comp->updateAll();
+            if (starting && comp->m_startCalled)
+                g_ticks.started = true;
+        }
+        else if (object->isEnabled()) {
+            if (object->m_ticks & TickUpdate)
+                object->update();
+            if (object->hasCoroutines())
+                object->resumeCoroutines();
+        }
+        if (object->m_schedule)
+            Engine::setTickDelta(-1.0f);
+    };
+    // children of parallel GameObjects update concurrently, deferring shared
+    // side effects into per child queues which are replayed in child order
+    bool transformsUpdated = false;
+    auto runParallel = [&run, &transformsUpdated](const GameObject* parent) {
+        auto& group = g_ticks.groups[parent];
+        if (group.dirty) {
+            // split the ticks where the child of parent owning them changes
+            group.segments.clear();
+            const GameObject* current = nullptr;
+            for (std::size_t i = 0; i < group.ticks.size(); ++i) {
+                const GameObject* child = group.ticks[i].owner;
+                while (child->m_tickParent != parent)
+                    child = child->m_tickParent;
+                if (child != current) {
+                    group.segments.push_back(i);
+                    current = child;
+                }
+            }
+            group.segments.push_back(group.ticks.size());
+            group.dirty = false;
+        }
+        if (group.ticks.empty())
+            return;
+        // start() commonly creates Objects, so it runs serially up front
+        for (auto& tick : group.ticks) {
+            if (tick.op == StartGameObject) {
+                run(tick);
+            }
+            else if (tick.op == UpdateComponent) {
+                auto comp = static_cast<Component*>(tick.object);
+                if (comp->isEnabled() && !comp->m_startCalled) {
+                    comp->start();
+                    comp->m_startCalled = true;
+                    g_ticks.started = true;
+                }
+            }
+        }
+        // world matrices are computed lazily, so clean them before reading
+        // concurrently: all of them before the first group, then only the
+        // subtree which its start() calls and the serial updates since may move
+        if (transformsUpdated) {
+            parent->validateTransforms();
+        }
+        else {
+            Transforms::detail::update();
+            transformsUpdated = true;
+        }
+        std::size_t count = group.segments.size() - 1;
+        std::vector<detail::DeferQueue> deferred(count);
+        Engine::jobs().parallelFor(count, [&](std::size_t begin, std::size_t end) {
+            auto& queue = detail::deferQueue();
+            auto previous = queue;
+            for (std::size_t s = begin; s < end; ++s) {
+                queue = &deferred[s];
+                for (std::size_t i = group.segments[s]; i < group.segments[s + 1]; ++i) {
+                    if (group.ticks[i].op != StartGameObject)
+                        run(group.ticks[i]);
+                }
+            }
+            queue = previous;
+        });
+        for (auto& queue : deferred) {
+            for (auto& call : queue)
+                call();
+        }
+    };
+    for (auto& tick : g_ticks.update) {
+        if (tick.op == UpdateParallel)
+            runParallel(tick.owner);
+        else
+            run(tick);
     }
+    // Low priority updates continue round-robin from where the last frame stopped
+    auto& low = g_ticks.lowUpdate;
+    if (!low.empty()) {
+        float budget = Engine::getUpdateBudget();
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t visited = 0; visited < low.size(); ++visited) {
+            run(low[g_ticks.lowCursor++ % low.size()]);
+            if (budget > 0.0f && std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budget)
+                break;
+        }
+        g_ticks.lowCursor %= low.size();
+    }
+    g_ticks.ticking = false;
+    if (g_ticks.started)
+        pruneTicks();
 }
 
+void GameObject::lateUpdateAll() {
+    buildTicks();
+    g_ticks.ticking = true;
+    for (auto& tick : g_ticks.lateUpdate)
+        tick.object->lateUpdate();
+    g_ticks.ticking = false;
+}
+
+void GameObject::onRender(RenderQue& que) {
+    buildTicks();
+    // number the Renderers in tree order, from the first entry that moved
+    auto& renderers = g_ticks.renderers;
+    for (std::size_t i = g_ticks.renumberFrom; i < renderers.size(); ++i)
+        static_cast<Renderer*>(renderers[i].object)->m_drawOrder = (std::uint32_t)i;
+    g_ticks.renumberFrom = renderers.size();
+    g_ticks.ticking = true;
+    for (auto& tick : g_ticks.render)
+        tick.object->onRender(que);
+    g_ticks.ticking = false;
+}
+
+void GameObject::onGizmo() {
+    buildTicks();
+    g_ticks.ticking = true;
+    for (auto& tick : g_ticks.gizmo) {
+        if (tick.object->isEnabled() && tick.object->showGizmos)
+            tick.object->onGizmo();
+    }
+    g_ticks.ticking = false;
+}
 
+void GameObject::onPhysics() {
+    buildTicks();
+    g_ticks.ticking = true;
+    for (auto& tick : g_ticks.physics)
+        tick.object->onPhysics();
+    g_ticks.ticking = false;
+}
 
 } // namespace carnot
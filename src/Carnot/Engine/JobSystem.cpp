@@ -0,0 +1,241 @@
+#include <Engine/JobSystem.hpp>
+#include <algorithm>
+
+namespace carnot {
+
+//==============================================================================
+// JOB
+//==============================================================================
+
+namespace detail {
+
+struct Job {
+    std::function<void()> fn;            ///< work to run
+    std::atomic<int> pending{1};         ///< unfinished dependencies + 1 until scheduled
+    std::atomic<bool> done{false};       ///< true once fn has returned
+    std::mutex mutex;                    ///< guards continuations and done transitions
+    std::vector<Ptr<Job>> continuations; ///< jobs depending on this one
+};
+
+} // namespace detail
+
+namespace {
+
+thread_local std::size_t t_threadIndex = 0;   ///< 1..N on workers, 0 elsewhere
+thread_local JobSystem*  t_jobSystem = nullptr; ///< JobSystem owning the worker
+
+} // private namespace
+
+JobHandle::JobHandle() { }
+
+bool JobHandle::isValid() const {
+    return m_job != nullptr;
+}
+
+bool JobHandle::isDone() const {
+    return !m_job || m_job->done.load(std::memory_order_acquire);
+}
+
+//==============================================================================
+// Constructor/Destructor
+//==============================================================================
+
+JobSystem::JobSystem(std::size_t workers) :
+    m_stop(false),
+    m_queued(0),
+    m_next(0)
+{
+    if (workers == 0) {
+        std::size_t hardware = std::thread::hardware_concurrency();
+        workers = hardware > 1 ? hardware - 1 : 1;
+    }
+    for (std::size_t i = 0; i < workers; ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+    for (std::size_t i = 0; i < workers; ++i)
+        m_workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    // drain remaining work so fire-and-forget jobs are not lost
+    while (m_queued.load() > 0)
+        runOne();
+    m_stop = true;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers)
+        worker->thread.join();
+}
+
+//==============================================================================
+// Scheduling
+//==============================================================================
+
+JobHandle JobSystem::schedule(std::function<void()> job) {
+    return schedule(std::move(job), {});
+}
+
+JobHandle JobSystem::schedule(std::function<void()> job, const std::vector<JobHandle>& dependencies) {
+    auto ptr = std::make_shared<detail::Job>();
+    ptr->fn = std::move(job);
+    ptr->pending = 1 + (int)dependencies.size();
+    for (auto& dependency : dependencies) {
+        if (!dependency.m_job) {
+            ptr->pending--;
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(dependency.m_job->mutex);
+        if (dependency.m_job->done)
+            ptr->pending--;
+        else
+            dependency.m_job->continuations.push_back(ptr);
+    }
+    JobHandle handle;
+    handle.m_job = ptr;
+    // release the scheduling guard
+    if (--ptr->pending == 0)
+        enqueue(std::move(ptr));
+    return handle;
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    while (!job.isDone()) {
+        if (!runOne())
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::wait(const std::vector<JobHandle>& jobs) {
+    for (auto& job : jobs)
+        wait(job);
+}
+
+void JobSystem::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& fn, std::size_t grain) {
+    if (count == 0)
+        return;
+    if (grain == 0)
+        grain = std::max<std::size_t>(1, count / (getThreadCount() * 4));
+    std::size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1) {
+        fn(0, count);
+        return;
+    }
+    // helpers and the caller claim chunks until none are left
+    std::atomic<std::size_t> next(0);
+    auto body = [&]() {
+        for (std::size_t c = next++; c < chunks; c = next++)
+            fn(c * grain, std::min(count, (c + 1) * grain));
+    };
+    std::vector<JobHandle> helpers;
+    std::size_t helperCount = std::min(chunks - 1, m_workers.size());
+    helpers.reserve(helperCount);
+    for (std::size_t i = 0; i < helperCount; ++i)
+        helpers.push_back(schedule(body));
+    body();
+    wait(helpers);
+}
+
+void JobSystem::runOnMainThread(std::function<void()> fn) {
+    std::lock_guard<std::mutex> lock(m_mainMutex);
+    m_mainJobs.push_back(std::move(fn));
+}
+
+//==============================================================================
+// Threads
+//==============================================================================
+
+std::size_t JobSystem::getThreadCount() const {
+    return m_workers.size() + 1;
+}
+
+std::size_t JobSystem::getThreadIndex() {
+    return t_threadIndex;
+}
+
+//==============================================================================
+// Private
+//==============================================================================
+
+void JobSystem::workerLoop(std::size_t index) {
+    t_threadIndex = index + 1;
+    t_jobSystem = this;
+    while (!m_stop) {
+        if (!runOne()) {
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this]() { return m_stop || m_queued.load() > 0; });
+        }
+    }
+}
+
+void JobSystem::enqueue(Ptr<detail::Job> job) {
+    // workers push to their own deque, other threads spread jobs round-robin
+    std::size_t target = t_jobSystem == this ? t_threadIndex - 1 : m_next++ % m_workers.size();
+    {
+        std::lock_guard<std::mutex> lock(m_workers[target]->mutex);
+        m_workers[target]->jobs.push_back(std::move(job));
+    }
+    m_queued++;
+    // lock so a worker between its predicate check and wait can't miss the notify
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+}
+
+bool JobSystem::runOne() {
+    Ptr<detail::Job> job;
+    std::size_t count = m_workers.size();
+    if (t_jobSystem == this) {
+        // pop newest from own deque (hot in cache)
+        auto& own = *m_workers[t_threadIndex - 1];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+    if (!job) {
+        // steal oldest from others
+        std::size_t start = t_jobSystem == this ? t_threadIndex : m_next.load();
+        for (std::size_t i = 0; i < count && !job; ++i) {
+            auto& victim = *m_workers[(start + i) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+            }
+        }
+    }
+    if (!job)
+        return false;
+    m_queued--;
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(const Ptr<detail::Job>& job) {
+    job->fn();
+    std::vector<Ptr<detail::Job>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done.store(true, std::memory_order_release);
+        continuations.swap(job->continuations);
+    }
+    for (auto& continuation : continuations) {
+        if (--continuation->pending == 0)
+            enqueue(std::move(continuation));
+    }
+}
+
+void JobSystem::runMainThreadJobs() {
+    std::vector<std::function<void()>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        jobs.swap(m_mainJobs);
+    }
+    for (auto& fn : jobs)
+        fn();
+}
+
+} // namespace carnot
@@ -3,8 +3,13 @@
 #include <Engine/Engine.hpp>
 #include <Engine/Object.hpp>
 #include <Engine/Coroutine.hpp>
+#include <Utility/DeferQueue.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
 
 namespace carnot {
 
@@ -19,9 +24,17 @@ std::size_t g_objectCount = 0;
 
 Object::Object(const Name& name) :
     m_id(ID::makeId(name)),
+    m_typeId(InvalidTypeId),
     m_enabled(true),
+    m_ticks(TickAll),
     showGizmos(true)
 {
+    // a hard check, since the Object pools and the Engine's bookkeeping
+    // aren't thread-safe and a race here corrupts memory silently
+    if (detail::isDeferring()) {
+        std::fprintf(stderr, "carnot: Objects can't be created during a parallel update, use GameObject::defer\n");
+        std::abort();
+    }
     g_objectCount++;
 }
 
@@ -54,7 +67,10 @@ Id Object::getId() const {
 }
 
 void Object::setEnabled(bool enabled) {
-    m_enabled = enabled;
+    if (enabled != m_enabled) {
+        m_enabled = enabled;
+        refreshTicks(true);
+    }
     if (enabled)
         onEnable();
     else
@@ -65,6 +81,84 @@ bool Object::isEnabled() const {
     return m_enabled;
 }
 
+TypeId Object::getTypeId() const {
+    return m_typeId;
+}
+
+//==============================================================================
+// Update Scheduling
+//==============================================================================
+
+namespace {
+
+/// Scrambles an Id so that consecutive Ids stagger evenly
+std::size_t staggerHash(Id id) {
+    std::uint64_t x = static_cast<std::uint64_t>(id) + 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<std::size_t>(x ^ (x >> 31));
+}
+
+} // private namespace
+
+void Object::setUpdateInterval(std::size_t frames) {
+    schedule().interval = frames > 0 ? frames : 1;
+}
+
+std::size_t Object::getUpdateInterval() const {
+    return m_schedule ? m_schedule->interval : 1;
+}
+
+void Object::setUpdateRate(float hz) {
+    auto& s = schedule();
+    s.period = hz > 0.0f ? 1.0f / hz : 0.0f;
+    s.nextTime = -1.0f;
+}
+
+float Object::getUpdateRate() const {
+    return m_schedule && m_schedule->period > 0.0f ? 1.0f / m_schedule->period : 0.0f;
+}
+
+void Object::setUpdatePriority(UpdatePriority priority) {
+    if (getUpdatePriority() != priority) {
+        schedule().priority = priority;
+        refreshTicks(false);
+    }
+}
+
+Object::UpdatePriority Object::getUpdatePriority() const {
+    return m_schedule ? m_schedule->priority : UpdatePriority::Normal;
+}
+
+Object::UpdateSchedule& Object::schedule() {
+    if (!m_schedule)
+        m_schedule = std::make_unique<UpdateSchedule>();
+    return *m_schedule;
+}
+
+bool Object::isUpdateDue() {
+    if (!m_schedule)
+        return true;
+    if (m_schedule->period > 0.0f) {
+        float now = Engine::time();
+        if (m_schedule->nextTime < 0.0f) {
+            // stagger the first update across one period
+            float phase = (float)(staggerHash(m_id) % 1024) / 1024.0f;
+            m_schedule->nextTime = now + phase * m_schedule->period;
+        }
+        if (now < m_schedule->nextTime)
+            return false;
+        m_schedule->nextTime += m_schedule->period;
+        // don't try to catch up after a stall
+        if (m_schedule->nextTime < now)
+            m_schedule->nextTime = now + m_schedule->period;
+        return true;
+    }
+    if (m_schedule->interval <= 1)
+        return true;
+    return (Engine::frame() + staggerHash(m_id)) % m_schedule->interval == 0;
+}
+
 //==============================================================================
 // Public Static Functions
 //==============================================================================
@@ -113,6 +207,18 @@ void Object::onDisable() {
     // do nothing by default
 }
 
+void Object::onSpawn() {
+    // do nothing by default
+}
+
+void Object::onDespawn() {
+    // do nothing by default
+}
+
+void Object::refreshTicks(bool subtree) {
+    // only GameObjects and Components are listed
+}
+
 
 //=============================================================================
 // Coroutines
@@ -121,6 +227,8 @@ void Object::onDisable() {
 Handle<Coroutine> Object::startCoroutine(Enumerator&& e) {
     auto h = e.getCoroutine();
     m_coroutines.push_back(std::move(e));
+    if (m_coroutines.size() == 1)
+        refreshTicks(false);
     return h;
 }
 
@@ -0,0 +1,356 @@
+#include <Engine/TransformSystem.hpp>
+#include <Engine/Components/Transform.hpp>
+#include <Engine/Engine.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace carnot {
+namespace Transforms {
+
+//==============================================================================
+// GLOBALS
+//==============================================================================
+
+namespace {
+
+/// Reorders v such that v[i] = old v[order[i]]
+template <typename T>
+void permute(std::vector<T>& v, const std::vector<std::size_t>& order) {
+    std::vector<T> sorted;
+    sorted.reserve(order.size());
+    for (auto i : order)
+        sorted.push_back(v[i]);
+    v.swap(sorted);
+}
+
+} // private namespace
+
+//==============================================================================
+// USER API
+//==============================================================================
+
+std::size_t getCount() {
+    return detail::store().count();
+}
+
+std::size_t getLevelCount() {
+    return detail::store().levelCount();
+}
+
+namespace detail {
+
+void init() {
+    store();
+}
+
+void update() {
+    store().updateAll();
+}
+
+void shutdown() {
+
+}
+
+Store& store() {
+    // intentionally never destroyed so Transforms outliving static
+    // destruction (e.g. held by user globals) can still release their slots
+    static Store* s_store = new Store();
+    return *s_store;
+}
+
+//==============================================================================
+// STORE
+//==============================================================================
+
+Store::Store() :
+    m_levels(1, 0),
+    m_generation(0),
+    m_dead(0),
+    m_sorted(true),
+    m_dirty(false)
+{ }
+
+std::size_t Store::allocate(Transform* _owner) {
+    std::size_t slot = owner.size();
+    owner.push_back(_owner);
+    parent.push_back(npos);
+    position.push_back(Vector2f(0, 0));
+    scale.push_back(Vector2f(1, 1));
+    origin.push_back(Vector2f(0, 0));
+    rotation.push_back(0);
+    l00.push_back(1); l01.push_back(0); l02.push_back(0);
+    l10.push_back(0); l11.push_back(1); l12.push_back(0);
+    w00.push_back(1); w01.push_back(0); w02.push_back(0);
+    w10.push_back(0); w11.push_back(1); w12.push_back(0);
+    localDirty.push_back(0);
+    worldDirty.push_back(1);
+    worldVersion.push_back(0);
+    parentVersion.push_back(0);
+    m_dirty = true;
+    return slot;
+}
+
+void Store::release(std::size_t slot) {
+    owner[slot] = nullptr;
+    localDirty[slot] = 0;
+    worldDirty[slot] = 0;
+    ++m_dead;
+}
+
+void Store::setParent(std::size_t slot, std::size_t _parent) {
+    if (parent[slot] == _parent)
+        return;
+    parent[slot] = _parent;
+    worldDirty[slot] = 1;
+    // slots in the sorted range have a fixed depth, and a parent must
+    // always precede its children for the linear pass to be valid
+    if (slot < m_levels.back() || (_parent != npos && _parent > slot))
+        m_sorted = false;
+    m_dirty = true;
+}
+
+void Store::makeLocalDirty(std::size_t slot) {
+    localDirty[slot] = 1;
+    worldDirty[slot] = 1;
+    m_dirty = true;
+}
+
+void Store::makeWorldDirty(std::size_t slot) {
+    worldDirty[slot] = 1;
+    m_dirty = true;
+}
+
+void Store::validate(std::size_t slot) {
+    if (localDirty[slot])
+        computeLocal(slot);
+    std::size_t p = parent[slot];
+    if (p != npos) {
+        validate(p);
+        if (worldDirty[slot] || parentVersion[slot] != worldVersion[p])
+            computeWorld(slot, ++m_generation);
+    }
+    else if (worldDirty[slot]) {
+        computeWorld(slot, ++m_generation);
+    }
+}
+
+void Store::validateFromParent(std::size_t slot) {
+    if (localDirty[slot])
+        computeLocal(slot);
+    std::size_t p = parent[slot];
+    if (worldDirty[slot] || (p != npos && parentVersion[slot] != worldVersion[p]))
+        computeWorld(slot, ++m_generation);
+}
+
+void Store::updateAll() {
+    if (!m_dirty)
+        return;
+    std::size_t n = owner.size();
+    // re-sort if the order is broken or the tail/dead slots grew large
+    if (!m_sorted || m_dead * 4 > n || (n - m_levels.back()) * 4 > n) {
+        sort();
+        n = owner.size();
+    }
+    // local matrices (independent per slot, so fork large stores across workers)
+    auto computeLocals = [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (localDirty[i])
+                computeLocal(i);
+        }
+    };
+    if (n >= 4096)
+        Engine::jobs().parallelFor(n, computeLocals, 1024);
+    else
+        computeLocals(0, n);
+    const std::size_t generation = ++m_generation;
+    // roots
+    if (m_levels.size() > 1) {
+        for (std::size_t i = m_levels[0]; i < m_levels[1]; ++i) {
+            if (worldDirty[i])
+                computeWorld(i, generation);
+        }
+    }
+    // sorted levels, parents before children
+    for (std::size_t l = 1; l + 1 < m_levels.size(); ++l)
+        composeLevel(m_levels[l], m_levels[l + 1], generation);
+    // unsorted tail, still parent-before-child
+    for (std::size_t i = m_levels.back(); i < n; ++i) {
+        if (owner[i] == nullptr)
+            continue;
+        std::size_t p = parent[i];
+        if (worldDirty[i] || (p != npos && parentVersion[i] != worldVersion[p]))
+            computeWorld(i, generation);
+    }
+    m_dirty = false;
+}
+
+std::size_t Store::count() const {
+    return owner.size() - m_dead;
+}
+
+std::size_t Store::levelCount() const {
+    return m_levels.size() - 1;
+}
+
+void Store::computeLocal(std::size_t i) {
+    float angle  = -rotation[i] * 3.141592654f / 180.f;
+    float cosine = static_cast<float>(std::cos(angle));
+    float sine   = static_cast<float>(std::sin(angle));
+    float sxc    = scale[i].x * cosine;
+    float syc    = scale[i].y * cosine;
+    float sxs    = scale[i].x * sine;
+    float sys    = scale[i].y * sine;
+    l00[i] = sxc;  l01[i] = sys; l02[i] = -origin[i].x * sxc - origin[i].y * sys + position[i].x;
+    l10[i] = -sxs; l11[i] = syc; l12[i] =  origin[i].x * sxs - origin[i].y * syc + position[i].y;
+    localDirty[i] = 0;
+}
+
+void Store::computeWorld(std::size_t i, std::size_t generation) {
+    std::size_t p = parent[i];
+    if (p != npos) {
+        w00[i] = w00[p] * l00[i] + w01[p] * l10[i];
+        w01[i] = w00[p] * l01[i] + w01[p] * l11[i];
+        w02[i] = w00[p] * l02[i] + w01[p] * l12[i] + w02[p];
+        w10[i] = w10[p] * l00[i] + w11[p] * l10[i];
+        w11[i] = w10[p] * l01[i] + w11[p] * l11[i];
+        w12[i] = w10[p] * l02[i] + w11[p] * l12[i] + w12[p];
+        parentVersion[i] = worldVersion[p];
+    }
+    else {
+        w00[i] = l00[i]; w01[i] = l01[i]; w02[i] = l02[i];
+        w10[i] = l10[i]; w11[i] = l11[i]; w12[i] = l12[i];
+    }
+    worldVersion[i] = generation;
+    worldDirty[i] = 0;
+}
+
+void Store::composeLevel(std::size_t begin, std::size_t end, std::size_t generation) {
+    const std::size_t n = end - begin;
+    if (n == 0)
+        return;
+    m_scratch.resize(n * 7);
+    float* __restrict p00  = &m_scratch[0];
+    float* __restrict p01  = p00 + n;
+    float* __restrict p02  = p01 + n;
+    float* __restrict p10  = p02 + n;
+    float* __restrict p11  = p10 + n;
+    float* __restrict p12  = p11 + n;
+    float* __restrict mask = p12 + n;
+    // gather parent matrices and stale mask (parents live in earlier levels)
+    bool any = false;
+    for (std::size_t j = 0; j < n; ++j) {
+        std::size_t i = begin + j;
+        std::size_t p = parent[i];
+        bool stale = worldDirty[i] || parentVersion[i] != worldVersion[p];
+        p00[j] = w00[p]; p01[j] = w01[p]; p02[j] = w02[p];
+        p10[j] = w10[p]; p11[j] = w11[p]; p12[j] = w12[p];
+        mask[j] = stale ? 1.0f : 0.0f;
+        any |= stale;
+    }
+    if (!any)
+        return;
+    // branch-free compose over contiguous arrays (auto-vectorized)
+    const float* __restrict a00 = &l00[begin]; const float* __restrict a01 = &l01[begin]; const float* __restrict a02 = &l02[begin];
+    const float* __restrict a10 = &l10[begin]; const float* __restrict a11 = &l11[begin]; const float* __restrict a12 = &l12[begin];
+    float* __restrict o00 = &w00[begin]; float* __restrict o01 = &w01[begin]; float* __restrict o02 = &w02[begin];
+    float* __restrict o10 = &w10[begin]; float* __restrict o11 = &w11[begin]; float* __restrict o12 = &w12[begin];
+    for (std::size_t j = 0; j < n; ++j) {
+        bool m = mask[j] != 0.0f;
+        float r00 = p00[j] * a00[j] + p01[j] * a10[j];
+        float r01 = p00[j] * a01[j] + p01[j] * a11[j];
+        float r02 = p00[j] * a02[j] + p01[j] * a12[j] + p02[j];
+        float r10 = p10[j] * a00[j] + p11[j] * a10[j];
+        float r11 = p10[j] * a01[j] + p11[j] * a11[j];
+        float r12 = p10[j] * a02[j] + p11[j] * a12[j] + p12[j];
+        o00[j] = m ? r00 : o00[j];
+        o01[j] = m ? r01 : o01[j];
+        o02[j] = m ? r02 : o02[j];
+        o10[j] = m ? r10 : o10[j];
+        o11[j] = m ? r11 : o11[j];
+        o12[j] = m ? r12 : o12[j];
+    }
+    // versions
+    for (std::size_t j = 0; j < n; ++j) {
+        if (mask[j] != 0.0f) {
+            std::size_t i = begin + j;
+            parentVersion[i] = worldVersion[parent[i]];
+            worldVersion[i] = generation;
+            worldDirty[i] = 0;
+        }
+    }
+}
+
+void Store::sort() {
+    const std::size_t n = owner.size();
+    // drop links to dead parents
+    for (std::size_t i = 0; i < n; ++i) {
+        if (parent[i] != npos && owner[parent[i]] == nullptr) {
+            parent[i] = npos;
+            worldDirty[i] = 1;
+        }
+    }
+    // compute depth of live slots
+    std::vector<std::size_t> depth(n, npos);
+    std::vector<std::size_t> chain;
+    std::size_t maxDepth = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (owner[i] == nullptr || depth[i] != npos)
+            continue;
+        std::size_t j = i;
+        while (j != npos && depth[j] == npos) {
+            chain.push_back(j);
+            j = parent[j];
+        }
+        std::size_t d = j == npos ? 0 : depth[j] + 1;
+        while (!chain.empty()) {
+            depth[chain.back()] = d++;
+            chain.pop_back();
+        }
+        maxDepth = std::max(maxDepth, d - 1);
+    }
+    // stable counting sort by depth
+    std::vector<std::size_t> counts(maxDepth + 2, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (owner[i] != nullptr)
+            counts[depth[i] + 1]++;
+    }
+    for (std::size_t d = 1; d < counts.size(); ++d)
+        counts[d] += counts[d - 1];
+    m_levels = counts;
+    std::vector<std::size_t> order(counts.back());
+    std::vector<std::size_t> remap(n, npos);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (owner[i] != nullptr) {
+            std::size_t k = counts[depth[i]]++;
+            order[k] = i;
+            remap[i] = k;
+        }
+    }
+    // permute every array
+    permute(owner, order);
+    permute(parent, order);
+    permute(position, order);
+    permute(scale, order);
+    permute(origin, order);
+    permute(rotation, order);
+    permute(l00, order); permute(l01, order); permute(l02, order);
+    permute(l10, order); permute(l11, order); permute(l12, order);
+    permute(w00, order); permute(w01, order); permute(w02, order);
+    permute(w10, order); permute(w11, order); permute(w12, order);
+    permute(localDirty, order);
+    permute(worldDirty, order);
+    permute(worldVersion, order);
+    permute(parentVersion, order);
+    // fix up parent links and owner slots
+    for (std::size_t i = 0; i < owner.size(); ++i) {
+        if (parent[i] != npos)
+            parent[i] = remap[parent[i]];
+        owner[i]->m_slot = i;
+    }
+    m_dead = 0;
+    m_sorted = true;
+}
+
+} // namespace detail
+} // namespace Transforms
+} // namespace carnot
@@ -33,7 +33,7 @@ std::size_t CircleShape::getSmoothness() const {
     return m_smoothness;
 }
 
-void CircleShape::transform(const Matrix3x3& matrix) {
+void CircleShape::transform(const Affine& matrix) {
     m_center = matrix.transformPoint(m_center);
     Shape::transform(matrix);
 }
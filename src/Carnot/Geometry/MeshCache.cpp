@@ -0,0 +1,119 @@
+#include <Geometry/MeshCache.hpp>
+#include <Geometry/Shape.hpp>
+#include <Carnot/Glue/earcut.inl>
+#include <mutex>
+#include <unordered_map>
+
+namespace carnot {
+
+namespace {
+
+/// Cached Mesh (the raw pointer identifies the entry once the Mesh expires)
+struct Entry {
+    const Mesh* mesh;
+    WkPtr<const Mesh> ptr;
+};
+
+std::mutex g_mutex;
+std::unordered_multimap<std::uint64_t, Entry> g_meshes;
+std::size_t g_hits   = 0;
+std::size_t g_misses = 0;
+
+/// FNV-1a over the contour sizes and vertex bit patterns
+std::uint64_t hashGeometry(const std::vector<Vector2f>& vertices, const std::vector<std::size_t>& contours) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&](const void* data, std::size_t size) {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(contours.data(), contours.size() * sizeof(std::size_t));
+    mix(vertices.data(), vertices.size() * sizeof(Vector2f));
+    return hash;
+}
+
+/// Removes an expiring Mesh from the cache, then deletes it
+void evict(const Mesh* mesh) {
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        auto range = g_meshes.equal_range(mesh->hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.mesh == mesh) {
+                g_meshes.erase(it);
+                break;
+            }
+        }
+    }
+    delete mesh;
+}
+
+} // private namespace
+
+namespace MeshCache {
+
+Ptr<const Mesh> get(const Shape& shape) {
+    static const Ptr<const Mesh> empty = make<Mesh>();
+    if (shape.getVerticesCount() < 3)
+        return empty;
+    // earcut polygon of the outer contour followed by each hole
+    std::vector<std::vector<Vector2f>> polygon(1 + shape.getHoleCount());
+    polygon[0] = shape.getVertices();
+    for (std::size_t i = 0; i < shape.getHoleCount(); ++i)
+        polygon[i+1] = shape.getHole(i).getVertices();
+    std::vector<Vector2f> vertices;
+    std::vector<std::size_t> contours(polygon.size());
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+        vertices.insert(vertices.end(), polygon[i].begin(), polygon[i].end());
+        contours[i] = polygon[i].size();
+    }
+    std::uint64_t hash = hashGeometry(vertices, contours);
+    // held until after the lock is released, since releasing the last
+    // reference to a colliding Mesh evicts it, which takes the lock
+    std::vector<Ptr<const Mesh>> candidates;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        auto range = g_meshes.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            candidates.push_back(it->second.ptr.lock());
+            auto& mesh = candidates.back();
+            if (mesh && mesh->contours == contours && mesh->vertices == vertices) {
+                g_hits++;
+                return mesh;
+            }
+        }
+        g_misses++;
+    }
+    // triangulate outside of the lock
+    Mesh* mesh = new Mesh();
+    mesh->indices  = mapbox::earcut<std::uint32_t>(polygon);
+    mesh->vertices = std::move(vertices);
+    mesh->contours = std::move(contours);
+    mesh->hash     = hash;
+    Ptr<const Mesh> ptr(mesh, evict);
+    // another thread may have cached the same geometry meanwhile, which only
+    // costs a duplicate until one of them is released
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_meshes.emplace(hash, Entry{mesh, ptr});
+    return ptr;
+}
+
+std::size_t getMeshCount() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_meshes.size();
+}
+
+std::size_t getHitCount() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_hits;
+}
+
+std::size_t getMissCount() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_misses;
+}
+
+} // namespace MeshCache
+
+} // namespace carnot
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <limits>
 #include "clipper/clipper.hpp"
+#include <Geometry/MeshCache.hpp>
 
 #define CLIPPER_PREC     1000.0f
 #define INV_CLIPPER_PREC 0.001f
@@ -95,7 +96,7 @@ void Shape::move(float x, float y) {
 }
 
 void Shape::move(const Vector2f& offset) {
-    Matrix3x3 matrix = Matrix3x3::Identity;
+    Affine matrix;
     matrix.translate(offset);
     transform(matrix);
 }
@@ -105,25 +106,28 @@ void Shape::scale(float x, float y) {
 }
 
 void Shape::scale(const Vector2f& scale) {
-    Matrix3x3 matrix = Matrix3x3::Identity;
+    Affine matrix;
     matrix.scale(scale);
     transform(matrix);
 }
 
 void Shape::rotate(float angle) {
-    Matrix3x3 matrix = Matrix3x3::Identity;
+    Affine matrix;
     matrix.rotate(angle);
     transform(matrix);
 }
 
-void Shape::transform(const Matrix3x3& matrix) {
-    for (std::size_t i = 0; i < m_points.size(); ++i)
-        m_points[i] = matrix.transformPoint(m_points[i]);
+void Shape::transform(const Affine& matrix) {
+    matrix.transformPoints(m_points, m_points);
     for (auto& hole : m_holes)
         hole.transform(matrix);
     makeCacheStale();
 }
 
+void Shape::transform(const Matrix3x3& matrix) {
+    transform(Affine(matrix));
+}
+
 void Shape::setRadius(std::size_t index, float radius, std::size_t smoothness) {
     if (radius >= 0.0f) {
         m_radii[index] = radius;
@@ -236,6 +240,14 @@ bool Shape::isConvex() const {
     return Math::isConvex(m_points);
 }
 
+std::vector<Vector2f> Shape::triangulate() const {
+    Ptr<const Mesh> mesh = MeshCache::get(*this);
+    std::vector<Vector2f> triangles(mesh->indices.size());
+    for (std::size_t i = 0; i < mesh->indices.size(); ++i)
+        triangles[i] = mesh->vertices[mesh->indices[i]];
+    return triangles;
+}
+
 //==============================================================================
 // PRIVATE FUNCTIONS
 //==============================================================================
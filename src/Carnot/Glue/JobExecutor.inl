@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Box2D/Common/b2TaskExecutor.h>
+#include <Engine/JobSystem.hpp>
+
+namespace carnot {
+namespace detail {
+
+/// Runs b2World tasks (island solving, particle kernels) on a JobSystem
+class JobExecutor : public b2TaskExecutor {
+public:
+
+    /// Constructs an executor submitting to jobs, which must outlive it
+    explicit JobExecutor(JobSystem& jobs) : m_jobs(jobs) { }
+
+    int32 GetThreadCount() const override {
+        return (int32)m_jobs.getThreadCount();
+    }
+
+    void ParallelFor(int32 count, int32 minChunk, b2ParallelTask* task) override {
+        m_jobs.parallelFor((std::size_t)count, [task](std::size_t begin, std::size_t end) {
+            task->Execute((int32)begin, (int32)end, (int32)JobSystem::getThreadIndex());
+        }, minChunk > 1 ? (std::size_t)minChunk : 0);
+    }
+
+private:
+
+    JobSystem& m_jobs; ///< JobSystem the tasks run on
+};
+
+} // namespace detail
+} // namespace carnot
@@ -0,0 +1,306 @@
+#include <Graphics/Components/InstancedShapeRenderer.hpp>
+#include <Engine/GameObject.hpp>
+#include <Engine/Engine.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace carnot {
+
+namespace {
+
+/// instances expanded per job when filling the vertex array
+constexpr std::size_t g_instanceGrain = 256;
+/// changed instances this close together are uploaded as one range, since
+/// each range costs a separate buffer update
+constexpr std::size_t g_coalesceGap = 16;
+/// most ranges uploaded per draw, beyond which the gap allowed doubles
+constexpr std::size_t g_maxRanges = 32;
+
+} // private namespace
+
+InstancedShapeRenderer::InstancedShapeRenderer(GameObject& _gameObject) :
+    Renderer(_gameObject),
+    m_shape(new Shape()),
+    m_cacheAge(0),
+    m_vertexBuffer(sf::Triangles, sf::VertexBuffer::Static),
+    m_needsUpdate(true)
+{
+    m_shapeWatcher = m_shape->watchCache([this]() { invalidateCulling(); });
+}
+
+InstancedShapeRenderer::~InstancedShapeRenderer() {
+    m_shape->unwatchCache(m_shapeWatcher);
+}
+
+InstancedShapeRenderer::InstancedShapeRenderer(GameObject& _gameObject, Ptr<Shape> shape) :
+    InstancedShapeRenderer(_gameObject)
+{
+    setShape(std::move(shape));
+}
+
+void InstancedShapeRenderer::setShape(Ptr<Shape> shape) {
+    m_shape->unwatchCache(m_shapeWatcher);
+    m_shape = std::move(shape);
+    m_shapeWatcher = m_shape->watchCache([this]() { invalidateCulling(); });
+    m_cacheAge = 0;
+    invalidateCulling();
+}
+
+Ptr<Shape> InstancedShapeRenderer::getShape() const {
+    return m_shape;
+}
+
+std::size_t InstancedShapeRenderer::addInstance(const Vector2f& position, const Color& color) {
+    Affine transform;
+    transform.translate(position);
+    m_instances.push_back({transform, color, true, false});
+    m_needsUpdate = true;
+    invalidateCulling();
+    return m_instances.size() - 1;
+}
+
+void InstancedShapeRenderer::setInstanceCount(std::size_t count) {
+    m_instances.resize(count, {Affine::Identity, Color::White, true, false});
+    m_needsUpdate = true;
+    invalidateCulling();
+}
+
+std::size_t InstancedShapeRenderer::getInstanceCount() const {
+    return m_instances.size();
+}
+
+void InstancedShapeRenderer::setInstanceTransform(std::size_t index, const Affine& transform) {
+    assert(index < m_instances.size());
+    const float* current = m_instances[index].transform.getMatrix();
+    if (std::equal(current, current + 6, transform.getMatrix()))
+        return;
+    m_instances[index].transform = transform;
+    invalidateInstance(index);
+    invalidateCulling();
+}
+
+void InstancedShapeRenderer::setInstanceTransform(std::size_t index, const Vector2f& position, float rotation, const Vector2f& scale) {
+    Affine transform;
+    transform.translate(position).rotate(rotation).scale(scale);
+    setInstanceTransform(index, transform);
+}
+
+const Affine& InstancedShapeRenderer::getInstanceTransform(std::size_t index) const {
+    assert(index < m_instances.size());
+    return m_instances[index].transform;
+}
+
+void InstancedShapeRenderer::setInstanceColor(std::size_t index, const Color& color) {
+    assert(index < m_instances.size());
+    if (m_instances[index].color == color)
+        return;
+    m_instances[index].color = color;
+    invalidateInstance(index);
+}
+
+const Color& InstancedShapeRenderer::getInstanceColor(std::size_t index) const {
+    assert(index < m_instances.size());
+    return m_instances[index].color;
+}
+
+void InstancedShapeRenderer::setInstanceEnabled(std::size_t index, bool enabled) {
+    assert(index < m_instances.size());
+    if (m_instances[index].enabled == enabled)
+        return;
+    m_instances[index].enabled = enabled;
+    invalidateInstance(index);
+    invalidateCulling();
+}
+
+bool InstancedShapeRenderer::isInstanceEnabled(std::size_t index) const {
+    assert(index < m_instances.size());
+    return m_instances[index].enabled;
+}
+
+FloatRect InstancedShapeRenderer::getLocalBounds() const {
+    updateVertexArray();
+    return m_bounds;
+}
+
+FloatRect InstancedShapeRenderer::getWorldBounds() const {
+    Affine T = gameObject.transform.getWorldAffine();
+    return T.transformRect(getLocalBounds());
+}
+
+//==============================================================================
+// PRIVATE
+//==============================================================================
+
+void InstancedShapeRenderer::updateVertexArray() const {
+    // fetch the shared Mesh if the Shape changed
+    if (!m_shape->cacheCurrent(m_cacheAge)) {
+        Ptr<const Mesh> mesh = MeshCache::get(*m_shape);
+        if (mesh != m_mesh) {
+            m_mesh = std::move(mesh);
+            m_meshBounds = FloatRect();
+            if (!m_mesh->vertices.empty()) {
+                Vector2f min = m_mesh->vertices[0], max = m_mesh->vertices[0];
+                for (auto& p : m_mesh->vertices) {
+                    min.x = std::min(min.x, p.x); min.y = std::min(min.y, p.y);
+                    max.x = std::max(max.x, p.x); max.y = std::max(max.y, p.y);
+                }
+                m_meshBounds = FloatRect(min, max - min);
+            }
+            m_needsUpdate = true;
+        }
+    }
+    const std::size_t meshSize = m_mesh->indices.size();
+    if (m_needsUpdate) {
+        m_vertexArray.resize(meshSize * m_instances.size());
+        m_instanceBounds.resize(m_instances.size());
+        expandInstances(0, m_instances.size());
+        updateBounds();
+        m_vertexBuffer.invalidate();
+        m_needsUpdate = false;
+        clearDirtyInstances();
+        return;
+    }
+    if (m_dirtyInstances.empty())
+        return;
+    std::sort(m_dirtyInstances.begin(), m_dirtyInstances.end());
+    // the bounds only need a full pass if a changed instance was on their edge
+    bool shrinks = false;
+    for (auto i : m_dirtyInstances) {
+        const FloatRect& r = m_instanceBounds[i];
+        if (r.width >= 0 && (r.left <= m_bounds.left || r.top <= m_bounds.top ||
+                             r.left + r.width >= m_bounds.left + m_bounds.width ||
+                             r.top + r.height >= m_bounds.top + m_bounds.height))
+            shrinks = true;
+    }
+    if (m_dirtyInstances.size() > g_instanceGrain) {
+        Engine::jobs().parallelFor(m_dirtyInstances.size(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i)
+                expandInstances(m_dirtyInstances[i], m_dirtyInstances[i] + 1);
+        }, g_instanceGrain);
+    }
+    else {
+        for (auto i : m_dirtyInstances)
+            expandInstances(i, i + 1);
+    }
+    if (shrinks || m_bounds == FloatRect()) {
+        updateBounds();
+    }
+    else {
+        // otherwise the bounds can only grow
+        Vector2f min(m_bounds.left, m_bounds.top);
+        Vector2f max(m_bounds.left + m_bounds.width, m_bounds.top + m_bounds.height);
+        for (auto i : m_dirtyInstances) {
+            const FloatRect& r = m_instanceBounds[i];
+            if (r.width < 0)
+                continue;
+            min.x = std::min(min.x, r.left);            min.y = std::min(min.y, r.top);
+            max.x = std::max(max.x, r.left + r.width);  max.y = std::max(max.y, r.top + r.height);
+        }
+        m_bounds = FloatRect(min, max - min);
+    }
+    // upload the changed instances' vertices, merging runs separated by small
+    // gaps, and widening the gaps allowed until there are few ranges
+    std::size_t gap = g_coalesceGap;
+    for (;;) {
+        std::size_t ranges = 1;
+        for (std::size_t i = 1; i < m_dirtyInstances.size(); ++i) {
+            if (m_dirtyInstances[i] - m_dirtyInstances[i - 1] > gap)
+                ranges++;
+        }
+        if (ranges <= g_maxRanges)
+            break;
+        gap *= 2;
+    }
+    std::size_t begin = m_dirtyInstances[0];
+    for (std::size_t i = 1; i <= m_dirtyInstances.size(); ++i) {
+        if (i == m_dirtyInstances.size() || m_dirtyInstances[i] - m_dirtyInstances[i - 1] > gap) {
+            std::size_t end = m_dirtyInstances[i - 1] + 1;
+            m_vertexBuffer.invalidate(begin * meshSize, (end - begin) * meshSize);
+            if (i < m_dirtyInstances.size())
+                begin = m_dirtyInstances[i];
+        }
+    }
+    clearDirtyInstances();
+}
+
+void InstancedShapeRenderer::expandInstances(std::size_t begin, std::size_t end) const {
+    // expand the mesh for every instance; disabled instances keep their slot
+    // as degenerate transparent triangles so the layout never changes
+    const std::vector<std::uint32_t>& indices = m_mesh->indices;
+    const std::vector<Vector2f>& points = m_mesh->vertices;
+    const std::size_t meshSize = indices.size();
+    auto expand = [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const Instance& instance = m_instances[i];
+            Vertex* out = m_vertexArray.data() + i * meshSize;
+            if (instance.enabled && meshSize > 0) {
+                for (std::size_t v = 0; v < meshSize; ++v) {
+                    out[v].position = instance.transform.transformPoint(points[indices[v]]);
+                    out[v].color = instance.color;
+                }
+                m_instanceBounds[i] = instance.transform.transformRect(m_meshBounds);
+            }
+            else {
+                for (std::size_t v = 0; v < meshSize; ++v) {
+                    out[v].position = Vector2f();
+                    out[v].color = Color::Transparent;
+                }
+                m_instanceBounds[i] = FloatRect(0, 0, -1, -1);
+            }
+        }
+    };
+    begin = std::min(begin, m_instances.size());
+    end = std::min(end, m_instances.size());
+    if (end - begin > g_instanceGrain) {
+        Engine::jobs().parallelFor(end - begin, [&](std::size_t first, std::size_t last) {
+            expand(begin + first, begin + last);
+        }, g_instanceGrain);
+    }
+    else {
+        expand(begin, end);
+    }
+}
+
+void InstancedShapeRenderer::updateBounds() const {
+    // bounds of the enabled instances
+    bool first = true;
+    Vector2f min, max;
+    for (auto& r : m_instanceBounds) {
+        if (r.width < 0)
+            continue;
+        if (first) {
+            min = Vector2f(r.left, r.top);
+            max = Vector2f(r.left + r.width, r.top + r.height);
+            first = false;
+        }
+        else {
+            min.x = std::min(min.x, r.left);            min.y = std::min(min.y, r.top);
+            max.x = std::max(max.x, r.left + r.width);  max.y = std::max(max.y, r.top + r.height);
+        }
+    }
+    m_bounds = first ? FloatRect() : FloatRect(min, max - min);
+}
+
+void InstancedShapeRenderer::invalidateInstance(std::size_t index) {
+    if (m_instances[index].dirty)
+        return;
+    m_instances[index].dirty = true;
+    m_dirtyInstances.push_back((std::uint32_t)index);
+}
+
+void InstancedShapeRenderer::clearDirtyInstances() const {
+    for (auto i : m_dirtyInstances) {
+        if (i < m_instances.size())
+            m_instances[i].dirty = false;
+    }
+    m_dirtyInstances.clear();
+}
+
+void InstancedShapeRenderer::render(RenderTarget& target) const {
+    updateVertexArray();
+    RenderStates states;
+    states.transform = gameObject.transform.getWorldMatrix();
+    m_vertexBuffer.draw(target, m_vertexArray, states);
+}
+
+} // namespace carnot
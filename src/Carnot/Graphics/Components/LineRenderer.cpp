@@ -7,6 +7,7 @@ namespace carnot {
 
     LineRenderer::LineRenderer(GameObject& _gameObject, std::size_t pointCount) :
         Renderer(_gameObject),
+        m_vertexBuffer(sf::LineStrip, sf::VertexBuffer::Stream),
         m_needsUpdate(true)
     {
         setPointCount(pointCount);
@@ -15,6 +16,7 @@ namespace carnot {
     void LineRenderer::setPointCount(std::size_t count) {
         m_vertexArray.resize(count);
         m_needsUpdate = true;
+        invalidateCulling();
     }
 
     std::size_t LineRenderer::getPointCount() const {
@@ -24,6 +26,7 @@ namespace carnot {
     void LineRenderer::setPoint(std::size_t index, Vector2f position) {
         m_vertexArray[index] = position;
         m_needsUpdate   = true;
+        invalidateCulling();
     }
 
     void LineRenderer::setPoint(std::size_t index, float x, float y) {
@@ -39,6 +42,7 @@ namespace carnot {
         v.position = position;
         m_vertexArray.push_back(v);
         m_needsUpdate    = true;
+        invalidateCulling();
     }
 
     void LineRenderer::addPoint(float x, float y) {
@@ -63,12 +67,13 @@ namespace carnot {
     }
 
     sf::FloatRect LineRenderer::getLocalBounds() const {
+        updateCache();
         return m_bounds;
     }
 
     sf::FloatRect LineRenderer::getWorldBounds() const {
-        Matrix3x3 T = gameObject.transform.getWorldMatrix();// * shape.getTransform();
-        return T.transformRect(m_bounds);
+        Affine T = gameObject.transform.getWorldAffine();// * shape.getTransform();
+        return T.transformRect(getLocalBounds());
     }
 
     void LineRenderer::updateBounds() const {
@@ -99,10 +104,10 @@ namespace carnot {
     void LineRenderer::updateColor() const {
         for (std::size_t i = 0; i < m_vertexArray.size(); ++i)
             m_vertexArray[i].color = m_color;
+        m_vertexBuffer.invalidate();
     }
 
-    void LineRenderer::render(sf::RenderTarget& target) const {
-        m_states.transform = gameObject.transform.getWorldMatrix();
+    void LineRenderer::updateCache() const {
         if (m_needsUpdate) {
            // update bounds
            updateBounds();
@@ -111,8 +116,12 @@ namespace carnot {
            // reset update flag
            m_needsUpdate = false;
         }
-        if (m_vertexArray.size() > 0)
-            target.draw(&m_vertexArray[0], m_vertexArray.size(), sf::LineStrip, m_states);
+    }
+
+    void LineRenderer::render(sf::RenderTarget& target) const {
+        m_states.transform = gameObject.transform.getWorldMatrix();
+        updateCache();
+        m_vertexBuffer.draw(target, m_vertexArray, m_states);
     }
 
 
@@ -1,23 +1,54 @@
 #include <Graphics/Components/Renderer.hpp>
 #include <Engine/Engine.hpp>
+#include <Graphics/CullGrid.hpp>
+#include <Utility/DeferQueue.hpp>
 #include <cassert>
 
 namespace carnot {
 
 namespace {
+/// Index of a Renderer missing from a list
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
 std::size_t g_rendererCount = 0;
+std::size_t g_uploadedBytes = 0;      ///< bytes uploaded so far this frame
+std::size_t g_uploadedBytesLast = 0;  ///< bytes uploaded to render the last frame
+std::size_t g_drawnLast = 0;          ///< Renderers drawn in the last frame
+std::size_t g_culledLast = 0;         ///< Renderers culled in the last frame
+float       g_cullingTimeLast = 0;    ///< milliseconds spent culling the last frame
+CullGrid    g_cullGrid;               ///< world bounds of the listed Renderers
+std::vector<Renderer*> g_cullRenderers; ///< Renderers by culling grid key
+std::vector<Renderer*> g_cullDirty;     ///< Renderers whose world bounds must be recomputed
+std::vector<Renderer*> g_cullPolled;    ///< listed Renderers whose local bounds are polled
+std::vector<std::uint32_t> g_cullKeys;  ///< keys found by the last query
 } // namespace
 
+namespace detail {
+
+void countUploadedBytes(std::size_t bytes) {
+    g_uploadedBytes += bytes;
+}
+
+} // namespace detail
+
 Renderer::Renderer(GameObject& _gameObject) :
     Component(_gameObject),
     m_states(RenderStates::Default),
-    m_layer(0)
+    m_layer(0),
+    m_cullKey(CullGrid::npos),
+    m_drawOrder(0),
+    m_dirtyIndex(npos),
+    m_pollIndex(npos),
+    m_polled(false)
 {
     g_rendererCount++;
+    // the Transform outlives its GameObject's other Components
+    m_transformConnection = gameObject.transform.onChanged.connect([this]() { invalidateCulling(); });
 }
 
 Renderer::~Renderer() {
     g_rendererCount--;
+    gameObject.transform.onChanged.disconnect(m_transformConnection);
+    setListed(false);
 }
 
 void Renderer::setLayer(std::size_t layer) {
@@ -51,9 +82,110 @@ std::size_t Renderer::getRendererCount() {
     return g_rendererCount;
 }
 
-void Renderer::onRender(RenderQue& que) {
-    if (isEnabled())
-        que[m_layer].emplace_back(this);
+std::size_t Renderer::getUploadedBytes() {
+    return g_uploadedBytesLast;
+}
+
+std::size_t Renderer::getDrawnCount() {
+    return g_drawnLast;
+}
+
+std::size_t Renderer::getCulledCount() {
+    return g_culledLast;
+}
+
+float Renderer::getCullingTime() {
+    return g_cullingTimeLast;
+}
+
+void Renderer::invalidateCulling() {
+    if (m_cullKey == CullGrid::npos || m_dirtyIndex != npos)
+        return;
+    if (auto queue = detail::deferQueue()) {
+        // parallel update, so que at the merge point
+        queue->push_back([this]() { invalidateCulling(); });
+        return;
+    }
+    m_dirtyIndex = g_cullDirty.size();
+    g_cullDirty.push_back(this);
+}
+
+void Renderer::pollCulling() {
+    m_polled = true;
+    if (m_cullKey != CullGrid::npos && m_pollIndex == npos) {
+        m_pollIndex = g_cullPolled.size();
+        g_cullPolled.push_back(this);
+    }
+}
+
+void Renderer::setListed(bool listed) {
+    if (listed && m_cullKey == CullGrid::npos) {
+        // gridded with its real bounds by the next updateCulling
+        m_cullKey = g_cullGrid.insert(FloatRect());
+        if (g_cullRenderers.size() <= m_cullKey)
+            g_cullRenderers.resize(m_cullKey + 1);
+        g_cullRenderers[m_cullKey] = this;
+        invalidateCulling();
+        if (m_polled)
+            pollCulling();
+    }
+    else if (!listed && m_cullKey != CullGrid::npos) {
+        g_cullGrid.remove(m_cullKey);
+        g_cullRenderers[m_cullKey] = nullptr;
+        m_cullKey = CullGrid::npos;
+        if (m_dirtyIndex != npos) {
+            g_cullDirty[m_dirtyIndex] = nullptr;
+            m_dirtyIndex = npos;
+        }
+        if (m_pollIndex != npos) {
+            g_cullPolled[m_pollIndex] = g_cullPolled.back();
+            g_cullPolled[m_pollIndex]->m_pollIndex = m_pollIndex;
+            g_cullPolled.pop_back();
+            m_pollIndex = npos;
+        }
+    }
+}
+
+void Renderer::endFrame(std::size_t drawn, std::size_t culled, float cullingTime) {
+    g_uploadedBytesLast = g_uploadedBytes;
+    g_uploadedBytes = 0;
+    g_drawnLast = drawn;
+    g_culledLast = culled;
+    g_cullingTimeLast = cullingTime;
+}
+
+void Renderer::updateCulling(float cellSize) {
+    // only rehash when the cell size is off by more than a factor of two, so
+    // that zooming doesn't rehash every frame
+    float current = g_cullGrid.getCellSize();
+    if (cellSize < 0.5f * current || cellSize > 2.0f * current)
+        g_cullGrid.setCellSize(cellSize);
+    for (auto renderer : g_cullPolled) {
+        if (renderer->getLocalBounds() != renderer->m_cullBounds)
+            renderer->invalidateCulling();
+    }
+    // static Renderers aren't visited at all
+    for (auto renderer : g_cullDirty) {
+        if (renderer == nullptr)
+            continue;
+        renderer->m_dirtyIndex = npos;
+        g_cullGrid.update(renderer->m_cullKey, renderer->getWorldBounds());
+        if (renderer->m_polled)
+            renderer->m_cullBounds = renderer->getLocalBounds();
+    }
+    g_cullDirty.clear();
+}
+
+std::size_t Renderer::findVisible(const FloatRect& rect, std::vector<const Renderer*>& out) {
+    g_cullKeys.clear();
+    g_cullGrid.query(rect, g_cullKeys);
+    for (auto key : g_cullKeys)
+        out.push_back(g_cullRenderers[key]);
+    return g_cullGrid.size() - g_cullKeys.size();
+}
+
+bool Renderer::batch(RenderBatch& batch) const {
+    return false;
 }
 
 
@@ -61,7 +193,7 @@ void Renderer::onGizmo() {
     static Id localBoundsId = Debug::gizmoId("Local Bounds");
     static Id worldBoundsId = Debug::gizmoId("World Bounds");
     // shape local bounds
-    Matrix3x3 T = gameObject.transform.getWorldMatrix(); // * shape.getTransform();
+    Affine T = gameObject.transform.getWorldAffine(); // * shape.getTransform();
     if (Debug::gizmoActive(localBoundsId)) {
         auto bounds = getLocalBounds();
         auto a = T.transformPoint(bounds.left,bounds.top);
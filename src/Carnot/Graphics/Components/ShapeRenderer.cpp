@@ -1,7 +1,7 @@
 #include <Graphics/Components/ShapeRenderer.hpp>
 #include <Engine/GameObject.hpp>
 #include <Engine/Engine.hpp>
-#include <Carnot/Glue/earcut.inl>
+#include <Graphics/RenderBatch.hpp>
 
 namespace carnot {
 
@@ -9,15 +9,21 @@ ShapeRenderer::ShapeRenderer(GameObject& _gameObject) :
     Renderer(_gameObject),
     m_shape(new Shape()),
     m_cacheAge(0),
+    m_vertexBuffer(sf::Triangles, sf::VertexBuffer::Static),
     m_texture(nullptr),
     m_textureRect(),
     m_effect(nullptr),
     m_needsUpdate(true)
 {
+    m_shapeWatcher = m_shape->watchCache([this]() { invalidateCulling(); });
     setTextureRect(IntRect(0, 0, 1, 1));
     setTexture(nullptr);
 }
 
+ShapeRenderer::~ShapeRenderer() {
+    m_shape->unwatchCache(m_shapeWatcher);
+}
+
 ShapeRenderer::ShapeRenderer(GameObject& _gameObject, Ptr<Shape> shape) :
     ShapeRenderer(_gameObject)
 {
@@ -25,13 +31,17 @@ ShapeRenderer::ShapeRenderer(GameObject& _gameObject, Ptr<Shape> shape) :
 }
 
 void ShapeRenderer::setShape(const Shape& shape) {
+    // notifies the watchers of m_shape, this one included
     *m_shape = shape;
     m_cacheAge = 0;
 }
 
 void ShapeRenderer::setShape(Ptr<Shape> shape) {
+    m_shape->unwatchCache(m_shapeWatcher);
     m_shape = std::move(shape);
+    m_shapeWatcher = m_shape->watchCache([this]() { invalidateCulling(); });
     m_cacheAge = 0;
+    invalidateCulling();
 }
 
 Ptr<Shape> ShapeRenderer::getShape() const {
@@ -114,36 +124,10 @@ BlendMode ShapeRenderer::getBlendMode(BlendMode mode) const {
 //==============================================================================
 
 void ShapeRenderer::updateVertexArray() const {
-    // make earcut polygon
-    std::vector<std::vector<Vector2f>> polygon(1 + m_shape->getHoleCount());
-    polygon[0] = m_shape->getVertices();
-    std::size_t n_vertices = polygon[0].size();
-    if (n_vertices < 3)
-        return;
-    // generate vertices for holes
-    for (std::size_t i = 0; i < m_shape->getHoleCount(); ++i) {
-        polygon[i+1] = m_shape->getHole(i).getVertices();
-        n_vertices += polygon[i+1].size();
-    }
-    // generate indices
-    std::vector<std::size_t> indices = mapbox::earcut<std::size_t>(polygon);
-    // resize vertex array
-    m_vertexArray.resize(indices.size());
-    // make cummulative sum of vertices in polygon
-    std::vector<std::size_t> sums(polygon.size() + 1);
-    sums[0] = 0;
-    for (std::size_t i = 1; i < polygon.size() + 1; ++i)
-        sums[i] = sums[i-1] + polygon[i-1].size();
-    // set vertex array positions
-    std::size_t index = 0, subIndex = 0;
-    for (std::size_t i = 0; i < indices.size(); ++i) {
-        for (index = 0; sums.size(); ++index) {
-            if (indices[i] < sums[index + 1])
-                break;
-        }
-        subIndex = indices[i] - sums[index];
-        m_vertexArray[i].position = polygon[index][subIndex];
-    }
+    m_vertexArray.resize(m_mesh->indices.size());
+    for (std::size_t i = 0; i < m_mesh->indices.size(); ++i)
+        m_vertexArray[i].position = m_mesh->vertices[m_mesh->indices[i]];
+    m_vertexBuffer.invalidate();
 }
 
 void ShapeRenderer::updateTexCoords() const {
@@ -164,33 +148,57 @@ void ShapeRenderer::updateTexCoords() const {
         m_vertexArray[i].texCoords.y =
             m_textureRect.top + m_textureRect.height * yratio;
     }
+    m_vertexBuffer.invalidate();
 }
 
 void ShapeRenderer::updateFillColors() const
 {
     for (std::size_t i = 0; i < m_vertexArray.size(); ++i)
         m_vertexArray[i].color = m_color;
+    m_vertexBuffer.invalidate();
 }
 
-void ShapeRenderer::render(RenderTarget& target) const {
-    m_states.transform = gameObject.transform.getWorldMatrix();
+void ShapeRenderer::updateCache() const {
     // check if our cache age is stale
     if (!m_shape->cacheCurrent(m_cacheAge)) {
+        // identical geometry shares a Mesh, so an unchanged Mesh means
+        // the vertex array is still current
+        Ptr<const Mesh> mesh = MeshCache::get(*m_shape);
+        if (mesh == m_mesh)
+            return;
+        m_mesh = std::move(mesh);
         // Update vertex array
         updateVertexArray();
         // Updaate texture coordinates
         updateTexCoords();
         // Fill color (solid)
         updateFillColors();
-    }    
+    }
+}
+
+void ShapeRenderer::render(RenderTarget& target) const {
+    m_states.transform = gameObject.transform.getWorldMatrix();
+    updateCache();
     // update effect shader
     if (m_effect)
         m_states.shader = m_effect->shader();
     else
         m_states.shader = nullptr;
     // draw
+    m_vertexBuffer.draw(target, m_vertexArray, m_states);
+}
+
+bool ShapeRenderer::batch(RenderBatch& batch) const {
+    // Effects set the uniforms of a shared shader for each renderer
+    if (m_effect)
+        return false;
+    updateCache();
+    if (m_vertexArray.size() > RenderBatch::MAX_VERTICES)
+        return false;
+    m_states.shader = nullptr;
     if (m_vertexArray.size() > 0)
-        target.draw(&m_vertexArray[0], m_vertexArray.size(), sf::Triangles, m_states);
+        batch.draw(&m_vertexArray[0], m_vertexArray.size(), gameObject.transform.getWorldAffine(), m_states);
+    return true;
 }
 
 FloatRect ShapeRenderer::getLocalBounds() const {
@@ -198,7 +206,7 @@ FloatRect ShapeRenderer::getLocalBounds() const {
 }
 
 FloatRect ShapeRenderer::getWorldBounds() const {
-    Matrix3x3 T = gameObject.transform.getWorldMatrix();
+    Affine T = gameObject.transform.getWorldAffine();
     return T.transformRect(getLocalBounds());
 }
 
@@ -208,20 +216,21 @@ void ShapeRenderer::onGizmo() {
 
     static Id wireframeId = Debug::gizmoId("Wireframe");
 
-    Matrix3x3 T = gameObject.transform.getWorldMatrix();
+    Affine T = gameObject.transform.getWorldAffine();
 
     // wireframe
     if (Debug::gizmoActive(wireframeId)) {
         std::vector<Vector2f> wireframe;
         wireframe.reserve(2 * m_vertexArray.size());
         for (std::size_t i = 0; i < m_vertexArray.size(); i = i + 3) {
-            wireframe.push_back(T.transformPoint(m_vertexArray[i].position    ));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i + 1].position));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i + 1].position));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i + 2].position));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i + 2].position));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i].position    ));
+            wireframe.push_back(m_vertexArray[i].position    );
+            wireframe.push_back(m_vertexArray[i + 1].position);
+            wireframe.push_back(m_vertexArray[i + 1].position);
+            wireframe.push_back(m_vertexArray[i + 2].position);
+            wireframe.push_back(m_vertexArray[i + 2].position);
+            wireframe.push_back(m_vertexArray[i].position    );
         }
+        T.transformPoints(wireframe, wireframe);
         Debug::drawLines(wireframe, Debug::getGizmoColor(wireframeId));
     }
 }
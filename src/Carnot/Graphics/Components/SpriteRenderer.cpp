@@ -1,12 +1,16 @@
 #include <Graphics/Components/SpriteRenderer.hpp>
 #include <Engine/GameObject.hpp>
 #include <Engine/Engine.hpp>
+#include <Graphics/RenderBatch.hpp>
+#include <cstdlib>
 
 namespace carnot {
 
 SpriteRenderer::SpriteRenderer(GameObject& _gameObject) :
     Renderer(_gameObject)
 {
+    // sprite is public, so its bounds can't report changes
+    pollCulling();
 }
 
 FloatRect SpriteRenderer::getLocalBounds() const {
@@ -14,7 +18,7 @@ FloatRect SpriteRenderer::getLocalBounds() const {
 }
 
 FloatRect SpriteRenderer::getWorldBounds() const {
-    Matrix3x3 T = gameObject.transform.getWorldMatrix();
+    Affine T = gameObject.transform.getWorldAffine();
     return T.transformRect(sprite.getGlobalBounds());
 }
 
@@ -23,4 +27,30 @@ void SpriteRenderer::render(RenderTarget& target) const {
     target.draw(sprite, m_states);
 }
 
+bool SpriteRenderer::batch(RenderBatch& batch) const {
+    const Texture* texture = sprite.getTexture();
+    if (!texture)
+        return true;
+    // same quad as sf::Sprite, as two triangles
+    IntRect rect = sprite.getTextureRect();
+    float width  = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+    float left   = static_cast<float>(rect.left);
+    float right  = left + rect.width;
+    float top    = static_cast<float>(rect.top);
+    float bottom = top + rect.height;
+    Color color  = sprite.getColor();
+    Vertex quad[6] = {
+        Vertex(Vector2f(0, 0),          color, Vector2f(left, top)),
+        Vertex(Vector2f(0, height),     color, Vector2f(left, bottom)),
+        Vertex(Vector2f(width, 0),      color, Vector2f(right, top)),
+        Vertex(Vector2f(width, 0),      color, Vector2f(right, top)),
+        Vertex(Vector2f(0, height),     color, Vector2f(left, bottom)),
+        Vertex(Vector2f(width, height), color, Vector2f(right, bottom))
+    };
+    m_states.texture = texture;
+    batch.draw(quad, 6, gameObject.transform.getWorldAffine() * Affine(sprite.getTransform()), m_states);
+    return true;
+}
+
 } // namespace carnot
@@ -4,6 +4,7 @@
 #include <SFML/OpenGL.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <Engine/DebugSystem.hpp>
+#include <Graphics/RenderBatch.hpp>
 
 #define PUSH_BACK_TRIANGLE(a,b,c) \
     m_vertexArray.push_back(static_cast<Vector2f>(a)); \
@@ -26,6 +27,7 @@ StrokeRenderer::StrokeRenderer(GameObject &_gameObject, std::size_t pointCount)
     Renderer(_gameObject),
     m_thickness(1),
     m_miterLimit(4),
+    m_vertexBuffer(sf::Triangles, sf::VertexBuffer::Static),
     m_needsUpdate(true)
 {
     setPointCount(pointCount);
@@ -37,6 +39,7 @@ void StrokeRenderer::setPointCount(std::size_t count)
     m_colors.resize(count, toRgb(Color()));
     m_thicknesses.resize(count, 1.0);
     m_needsUpdate = true;
+    invalidateCulling();
 }
 
 std::size_t StrokeRenderer::getPointCount() const
@@ -48,6 +51,7 @@ void StrokeRenderer::setPoint(std::size_t index, Vector2f position)
 {
     m_points[index] = static_cast<Vector2d>(position);
     m_needsUpdate = true;
+    invalidateCulling();
 }
 
 void StrokeRenderer::setPoint(std::size_t index, float x, float y)
@@ -66,6 +70,7 @@ void StrokeRenderer::addVertex(Vector2f position, const Color& color, float thic
     m_colors.push_back(toRgb(color));
     m_thicknesses.push_back(static_cast<double>(thickness));
     m_needsUpdate = true;
+    invalidateCulling();
 }
 
 void StrokeRenderer::addVertex(float x, float y, const Color& color, float thickness)
@@ -87,12 +92,14 @@ void StrokeRenderer::setThickness(float thickness) {
     m_thickness = thickness;
     std::fill(m_thicknesses.begin(), m_thicknesses.end(), thickness);
     m_needsUpdate = true;
+    invalidateCulling();
 }
 
 void StrokeRenderer::setThickness(std::size_t index, float thickness)
 {
     m_thicknesses[index] = static_cast<double>(std::abs(thickness));
     m_needsUpdate = true;
+    invalidateCulling();
 }
 
 float StrokeRenderer::getThickness(std::size_t index) const
@@ -118,6 +125,7 @@ Color StrokeRenderer::getColor(std::size_t index) const
 void StrokeRenderer::setMiterLimit(float miterLimit) {
     m_miterLimit = miterLimit;
     m_needsUpdate = true;
+    invalidateCulling();
 }
 
 float StrokeRenderer::getMiterLimit() const {
@@ -126,13 +134,14 @@ float StrokeRenderer::getMiterLimit() const {
 
 sf::FloatRect StrokeRenderer::getLocalBounds() const
 {
+    updateCache();
     return m_bounds;
 }
 
 sf::FloatRect StrokeRenderer::getWorldBounds() const
 {
-    Matrix3x3 T = gameObject.transform.getWorldMatrix(); // * shape.getTransform();
-    return T.transformRect(m_bounds);
+    Affine T = gameObject.transform.getWorldAffine(); // * shape.getTransform();
+    return T.transformRect(getLocalBounds());
 }
 
 void StrokeRenderer::updateVertexArray() const {
@@ -302,8 +311,7 @@ void StrokeRenderer::updateBounds() const
     }
 }
 
-void StrokeRenderer::render(sf::RenderTarget& target) const {
-    m_states.transform = gameObject.transform.getWorldMatrix();
+void StrokeRenderer::updateCache() const {
     if (m_needsUpdate) {
         // update vertex array
         updateVertexArray();
@@ -313,15 +321,29 @@ void StrokeRenderer::render(sf::RenderTarget& target) const {
         updateColor();
         // reset update flag
         m_needsUpdate = false;
+        m_vertexBuffer.invalidate();
     }
-    if (m_vertexArray.size()>0)
-        target.draw(&m_vertexArray[0], m_vertexArray.size(), sf::Triangles, m_states);
+}
+
+void StrokeRenderer::render(sf::RenderTarget& target) const {
+    m_states.transform = gameObject.transform.getWorldMatrix();
+    updateCache();
+    m_vertexBuffer.draw(target, m_vertexArray, m_states);
+}
+
+bool StrokeRenderer::batch(RenderBatch& batch) const {
+    updateCache();
+    if (m_vertexArray.size() > RenderBatch::MAX_VERTICES)
+        return false;
+    if (m_vertexArray.size() > 0)
+        batch.draw(&m_vertexArray[0], m_vertexArray.size(), gameObject.transform.getWorldAffine(), m_states);
+    return true;
 }
 
 void StrokeRenderer::onGizmo()
 {
     static Id wireframeId = Debug::gizmoId("Wireframe");
-    Matrix3x3 T = gameObject.transform.getWorldMatrix();
+    Affine T = gameObject.transform.getWorldAffine();
 
     Renderer::onGizmo();
     // wireframe
@@ -329,13 +351,14 @@ void StrokeRenderer::onGizmo()
         std::vector<Vector2f> wireframe;
         wireframe.reserve(2 * m_vertexArray.size());
         for (std::size_t i = 0; i < m_vertexArray.size(); i = i + 3) {
-            wireframe.push_back(T.transformPoint(m_vertexArray[i].position    ));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i + 1].position));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i + 1].position));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i + 2].position));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i + 2].position));
-            wireframe.push_back(T.transformPoint(m_vertexArray[i].position    ));
+            wireframe.push_back(m_vertexArray[i].position    );
+            wireframe.push_back(m_vertexArray[i + 1].position);
+            wireframe.push_back(m_vertexArray[i + 1].position);
+            wireframe.push_back(m_vertexArray[i + 2].position);
+            wireframe.push_back(m_vertexArray[i + 2].position);
+            wireframe.push_back(m_vertexArray[i].position    );
         }
+        T.transformPoints(wireframe, wireframe);
         Debug::drawLines(wireframe, Debug::getGizmoColor(wireframeId));
     }
 }
@@ -9,6 +9,8 @@ TextRenderer::TextRenderer(GameObject& _gameObject) :
 {
     static Id defaultFontId = ID::getId("Roboto");
     text.setFont(Engine::fonts.get(defaultFontId));
+    // text is public, so its bounds can't report changes
+    pollCulling();
 }
 
 FloatRect TextRenderer::getLocalBounds() const {
@@ -16,7 +18,7 @@ FloatRect TextRenderer::getLocalBounds() const {
 }
 
 FloatRect TextRenderer::getWorldBounds() const {
-    Matrix3x3 T = gameObject.transform.getWorldMatrix();
+    Affine T = gameObject.transform.getWorldAffine();
     return T.transformRect(text.getGlobalBounds());
 }
 
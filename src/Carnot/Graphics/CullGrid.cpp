@@ -0,0 +1,194 @@
+#include <Graphics/CullGrid.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace carnot {
+
+namespace {
+
+/// cell coordinates beyond this are kept in the large list to avoid overflow
+constexpr float g_maxCell = 1e9f;
+
+inline bool overlaps(const FloatRect& a, const FloatRect& b) {
+    // inclusive, so zero width/height bounds (e.g. straight lines) still overlap
+    return a.left <= b.left + b.width  && b.left <= a.left + a.width &&
+           a.top  <= b.top  + b.height && b.top  <= a.top  + a.height;
+}
+
+} // private namespace
+
+CullGrid::CullGrid() :
+    m_cellSize(1.0f),
+    m_invCellSize(1.0f),
+    m_buckets(1)
+{ }
+
+void CullGrid::setCellSize(float cellSize) {
+    cellSize = std::max(cellSize, 1.0f);
+    if (cellSize == m_cellSize)
+        return;
+    m_cellSize = cellSize;
+    m_invCellSize = 1.0f / m_cellSize;
+    // every item may change cell, or become large or small
+    for (auto& bucket : m_buckets)
+        bucket.clear();
+    m_large.clear();
+    for (std::uint32_t key = 0; key < (std::uint32_t)m_items.size(); ++key) {
+        if (m_items[key].list != FREE)
+            place(key);
+    }
+}
+
+float CullGrid::getCellSize() const {
+    return m_cellSize;
+}
+
+std::uint32_t CullGrid::insert(const FloatRect& bounds) {
+    std::uint32_t key;
+    if (!m_free.empty()) {
+        key = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        key = (std::uint32_t)m_items.size();
+        m_items.emplace_back();
+    }
+    m_items[key].bounds = bounds;
+    place(key);
+    // keep about one item per bucket
+    if (size() > m_buckets.size())
+        rehash(2 * m_buckets.size());
+    return key;
+}
+
+void CullGrid::update(std::uint32_t key, const FloatRect& bounds) {
+    assert(key < m_items.size() && m_items[key].list != FREE);
+    Item& item = m_items[key];
+    float cx, cy;
+    bool large = isLarge(bounds, cx, cy);
+    // items which stay in the same cell keep their place
+    if (!large && item.list != LARGE && item.x == (std::int32_t)std::floor(cx) && item.y == (std::int32_t)std::floor(cy)) {
+        item.bounds = bounds;
+        return;
+    }
+    unplace(key);
+    item.bounds = bounds;
+    place(key);
+}
+
+void CullGrid::remove(std::uint32_t key) {
+    assert(key < m_items.size() && m_items[key].list != FREE);
+    unplace(key);
+    m_items[key].list = FREE;
+    m_free.push_back(key);
+}
+
+void CullGrid::clear() {
+    m_items.clear();
+    m_free.clear();
+    m_large.clear();
+    for (auto& bucket : m_buckets)
+        bucket.clear();
+}
+
+void CullGrid::query(const FloatRect& rect, std::vector<std::uint32_t>& out) const {
+    float half = 0.5f * m_cellSize;
+    float x0 = std::floor((rect.left - half) * m_invCellSize);
+    float y0 = std::floor((rect.top - half) * m_invCellSize);
+    float x1 = std::floor((rect.left + rect.width + half) * m_invCellSize);
+    float y1 = std::floor((rect.top + rect.height + half) * m_invCellSize);
+    // visiting more cells than there are buckets costs more than a linear scan
+    float cells = (x1 - x0 + 1) * (y1 - y0 + 1);
+    bool inRange = std::abs(x0) < g_maxCell && std::abs(x1) < g_maxCell &&
+                   std::abs(y0) < g_maxCell && std::abs(y1) < g_maxCell;
+    if (!inRange || !(cells <= (float)m_buckets.size())) {
+        for (std::uint32_t key = 0; key < (std::uint32_t)m_items.size(); ++key) {
+            const Item& item = m_items[key];
+            if (item.list != FREE && item.list != LARGE && overlaps(item.bounds, rect))
+                out.push_back(key);
+        }
+    }
+    else {
+        for (auto y = (std::int32_t)y0; y <= (std::int32_t)y1; ++y) {
+            for (auto x = (std::int32_t)x0; x <= (std::int32_t)x1; ++x) {
+                for (auto key : m_buckets[bucket(x, y)]) {
+                    const Item& item = m_items[key];
+                    // buckets are shared by many cells, so match the cell too
+                    if (item.x == x && item.y == y && overlaps(item.bounds, rect))
+                        out.push_back(key);
+                }
+            }
+        }
+    }
+    for (auto key : m_large) {
+        if (overlaps(m_items[key].bounds, rect))
+            out.push_back(key);
+    }
+}
+
+std::size_t CullGrid::size() const {
+    return m_items.size() - m_free.size();
+}
+
+//==============================================================================
+// PRIVATE
+//==============================================================================
+
+bool CullGrid::isLarge(const FloatRect& bounds, float& cx, float& cy) const {
+    cx = (bounds.left + 0.5f * bounds.width) * m_invCellSize;
+    cy = (bounds.top + 0.5f * bounds.height) * m_invCellSize;
+    // a rectangle no larger than a cell lies within its center cell grown by
+    // half a cell on each side, which bounds the cells a query must visit
+    return bounds.width > m_cellSize || bounds.height > m_cellSize ||
+           !(std::abs(cx) < g_maxCell && std::abs(cy) < g_maxCell);
+}
+
+void CullGrid::place(std::uint32_t key) {
+    Item& item = m_items[key];
+    float cx, cy;
+    if (isLarge(item.bounds, cx, cy)) {
+        item.list = LARGE;
+        item.index = (std::uint32_t)m_large.size();
+        m_large.push_back(key);
+        return;
+    }
+    item.x = (std::int32_t)std::floor(cx);
+    item.y = (std::int32_t)std::floor(cy);
+    item.list = (std::uint32_t)bucket(item.x, item.y);
+    item.index = (std::uint32_t)m_buckets[item.list].size();
+    m_buckets[item.list].push_back(key);
+}
+
+void CullGrid::unplace(std::uint32_t key) {
+    Item& item = m_items[key];
+    auto& list = item.list == LARGE ? m_large : m_buckets[item.list];
+    // swap with the last key of the list
+    std::uint32_t last = list.back();
+    list[item.index] = last;
+    m_items[last].index = item.index;
+    list.pop_back();
+}
+
+void CullGrid::rehash(std::size_t bucketCount) {
+    // power of two bucket count
+    assert((bucketCount & (bucketCount - 1)) == 0);
+    for (auto& bucket : m_buckets)
+        bucket.clear();
+    m_buckets.resize(bucketCount);
+    for (std::uint32_t key = 0; key < (std::uint32_t)m_items.size(); ++key) {
+        Item& item = m_items[key];
+        if (item.list == FREE || item.list == LARGE)
+            continue;
+        item.list = (std::uint32_t)bucket(item.x, item.y);
+        item.index = (std::uint32_t)m_buckets[item.list].size();
+        m_buckets[item.list].push_back(key);
+    }
+}
+
+std::size_t CullGrid::bucket(std::int32_t x, std::int32_t y) const {
+    std::uint32_t h = ((std::uint32_t)x * 73856093u) ^ ((std::uint32_t)y * 19349663u);
+    return h & (std::uint32_t)(m_buckets.size() - 1);
+}
+
+} // namespace carnot
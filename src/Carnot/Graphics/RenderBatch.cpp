@@ -0,0 +1,49 @@
+#include <Graphics/RenderBatch.hpp>
+#include <Graphics/Components/Renderer.hpp>
+#include <cassert>
+
+namespace carnot {
+
+RenderBatch::RenderBatch() :
+    m_target(nullptr),
+    m_states(RenderStates::Default)
+{ }
+
+void RenderBatch::begin(RenderTarget& target) {
+    flush();
+    m_target = &target;
+}
+
+void RenderBatch::draw(const Vertex* vertices, std::size_t count, const Affine& transform, const RenderStates& states) {
+    assert(m_target && "RenderBatch::begin must be called before drawing");
+    if (count == 0)
+        return;
+    if (!m_vertices.empty() &&
+        (states.texture   != m_states.texture ||
+         states.shader    != m_states.shader  ||
+         states.blendMode != m_states.blendMode))
+        flush();
+    m_states.texture   = states.texture;
+    m_states.shader    = states.shader;
+    m_states.blendMode = states.blendMode;
+    std::size_t first = m_vertices.size();
+    m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+    // positions are strided by color and texCoords, so they are packed for
+    // the SIMD transform and written back
+    m_points.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        m_points[i] = vertices[i].position;
+    transform.transformPoints(&m_points[0], &m_points[0], count);
+    for (std::size_t i = 0; i < count; ++i)
+        m_vertices[first + i].position = m_points[i];
+}
+
+void RenderBatch::flush() {
+    if (m_vertices.empty())
+        return;
+    m_target->draw(&m_vertices[0], m_vertices.size(), sf::Triangles, m_states);
+    detail::countUploadedBytes(m_vertices.size() * sizeof(Vertex));
+    m_vertices.clear();
+}
+
+} // namespace carnot
@@ -0,0 +1,71 @@
+#include <Graphics/RetainedVertexBuffer.hpp>
+#include <Graphics/Components/Renderer.hpp>
+#include <Engine/Engine.hpp>
+#include <algorithm>
+
+namespace carnot {
+
+RetainedVertexBuffer::RetainedVertexBuffer(sf::PrimitiveType type, sf::VertexBuffer::Usage usage) :
+    m_buffer(type, usage),
+    m_count(0),
+    m_uploadFrame(0),
+    m_dirty(true)
+{ }
+
+void RetainedVertexBuffer::invalidate() {
+    m_dirty = true;
+}
+
+void RetainedVertexBuffer::invalidate(std::size_t first, std::size_t count) {
+    if (count == 0)
+        return;
+    // extend the last range if this one touches it
+    if (!m_ranges.empty() && first <= m_ranges.back().second && first + count >= m_ranges.back().first) {
+        m_ranges.back().first = std::min(m_ranges.back().first, first);
+        m_ranges.back().second = std::max(m_ranges.back().second, first + count);
+        return;
+    }
+    m_ranges.emplace_back(first, first + count);
+}
+
+void RetainedVertexBuffer::draw(RenderTarget& target, const std::vector<Vertex>& vertices, const RenderStates& states) {
+    if (vertices.empty())
+        return;
+    if (!sf::VertexBuffer::isAvailable()) {
+        detail::countUploadedBytes(vertices.size() * sizeof(Vertex));
+        target.draw(&vertices[0], vertices.size(), m_buffer.getPrimitiveType(), states);
+        return;
+    }
+    if (m_dirty || m_count != vertices.size() || !m_ranges.empty()) {
+        // geometry changing every frame, wholly or in part, is better streamed
+        std::size_t frame = Engine::frame();
+        bool stream = m_buffer.getUsage() == sf::VertexBuffer::Static && m_count > 0 && frame == m_uploadFrame + 1;
+        if (stream)
+            m_buffer.setUsage(sf::VertexBuffer::Stream);
+        if (m_dirty || m_count != vertices.size() || stream) {
+            // (re)create the buffer so a new usage applies, otherwise update()
+            // grows it when needed and a larger one is drawn partially
+            if (stream || m_buffer.getVertexCount() == 0)
+                m_buffer.create(vertices.size());
+            m_buffer.update(&vertices[0], vertices.size(), 0);
+            detail::countUploadedBytes(vertices.size() * sizeof(Vertex));
+            m_count = vertices.size();
+            m_dirty = false;
+        }
+        else {
+            // only the changed ranges go to the GPU
+            for (auto& range : m_ranges) {
+                std::size_t end = std::min(range.second, m_count);
+                if (range.first < end) {
+                    m_buffer.update(&vertices[range.first], end - range.first, static_cast<unsigned int>(range.first));
+                    detail::countUploadedBytes((end - range.first) * sizeof(Vertex));
+                }
+            }
+        }
+        m_uploadFrame = frame;
+    }
+    m_ranges.clear();
+    target.draw(m_buffer, 0, m_count, states);
+}
+
+} // namespace carnot
@@ -16,7 +16,12 @@ static const char RBShapeTypeSegment = 2;
 
 RigidBody::RigidBody(GameObject& _gameObject, BodyType type) :
     Component(_gameObject),
-    m_body(nullptr)
+    m_body(nullptr),
+    m_prevAngle(0.0f),
+    m_interpolated(true),
+    m_syncPending(true),
+    m_syncedAngle(0.0f),
+    m_syncedVersion(0)
 {
     // create body definition
     b2BodyDef def;
@@ -44,9 +49,16 @@ RigidBody::RigidBody(GameObject& _gameObject, BodyType type) :
     m_body->SetUserData(this);
     // set initial position
     syncWithTransform();
+    // sleeping bodies are skipped by the sync pass, so moves made by anything
+    // else (including a parent) flag the Transform to be put back
+    m_transformConnection = gameObject.transform.onChanged.connect([this]() {
+        if (gameObject.transform.getVersion() != m_syncedVersion)
+            m_syncPending = true;
+    });
 }
 
 RigidBody::~RigidBody() {
+    gameObject.transform.onChanged.disconnect(m_transformConnection);
     Physics::detail::world()->DestroyBody(m_body);
 }
 
@@ -270,6 +282,9 @@ float RigidBody::getShapeRestitution(std::size_t index) const {
 
 void RigidBody::setPosition(const Vector2f& position) {
     m_body->SetTransform(toB2D(position), m_body->GetAngle());
+    // teleport, so don't interpolate from the old pose
+    storePreviousPose();
+    m_syncPending = true;
 }
 
 void RigidBody::setPosition(float x, float y) {
@@ -282,6 +297,8 @@ Vector2f RigidBody::getPosition() const {
 
 void RigidBody::setRotation(float angle) {
     m_body->SetTransform(m_body->GetPosition(), toB2D(angle));
+    storePreviousPose();
+    m_syncPending = true;
 }
 
 float RigidBody::getRotation() const {
@@ -329,20 +346,67 @@ std::size_t RigidBody::getRigidBodyCount() {
 // OVERRIDE
 //==============================================================================
 
-void RigidBody::onPhysics() {
-    auto position = getPosition();
-    auto angle = getRotation();
-    gameObject.transform.setPosition(position);
-    gameObject.transform.setRotation(angle);
+void RigidBody::setInterpolated(bool interpolated) {
+    m_interpolated = interpolated;
+}
+
+bool RigidBody::isInterpolated() const {
+    return m_interpolated;
+}
+
+void RigidBody::syncTransform() {
+    b2Vec2 position = m_body->GetPosition();
+    float angle = m_body->GetAngle();
+    bool awake = m_body->IsAwake();
+    // sleeping bodies get their exact final pose once
+    if (m_interpolated && awake) {
+        float alpha = Physics::getAlpha();
+        position.x = m_prevPosition.x + alpha * (position.x - m_prevPosition.x);
+        position.y = m_prevPosition.y + alpha * (position.y - m_prevPosition.y);
+        angle = m_prevAngle + alpha * (angle - m_prevAngle);
+    }
+    m_syncPending = awake;
+    Vector2f worldPosition = fromB2D(position);
+    float worldAngle = fromB2D(angle);
+    // skip the write if the Transform still holds this pose
+    if (worldPosition == m_syncedPosition && worldAngle == m_syncedAngle &&
+        gameObject.transform.getVersion() == m_syncedVersion)
+        return;
+    m_syncedPosition = worldPosition;
+    m_syncedAngle = worldAngle;
+    gameObject.transform.setPositionAndRotation(worldPosition, worldAngle);
+    m_syncedVersion = gameObject.transform.getVersion();
+}
+
+void RigidBody::onSpawn() {
+    m_body->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+    m_body->SetAngularVelocity(0.0f);
+    syncWithTransform();
+    m_body->SetActive(true);
+    m_body->SetAwake(true);
+}
+
+void RigidBody::onDespawn() {
+    m_body->SetActive(false);
 }
 
 //==============================================================================
 // PRIVATE
 //==============================================================================
 
+void RigidBody::storePreviousPose() {
+    const b2Vec2& position = m_body->GetPosition();
+    m_prevPosition = Vector2f(position.x, position.y);
+    m_prevAngle = m_body->GetAngle();
+}
+
 void RigidBody::syncWithTransform() {
     setPosition(gameObject.transform.getPosition());
     setRotation(gameObject.transform.getRotation());
+    // the Transform holds the body's pose now
+    m_syncedPosition = getPosition();
+    m_syncedAngle = getRotation();
+    m_syncedVersion = gameObject.transform.getVersion();
 }
 
 } // namespace carnot
@@ -1,9 +1,13 @@
 #include <Physics/PhysicsSystem.hpp>
 #include <Carnot/Glue/Box2D.inl>
+#include <Carnot/Glue/JobExecutor.inl>
 #include <Engine/DebugSystem.hpp>
+#include <Engine/Engine.hpp>
+#include <Engine/JobSystem.hpp>
 #include <Graphics/NamedColors.hpp>
 #include <Utility/Print.hpp>
 #include <Physics/Components/RigidBody.hpp>
+#include <cmath>
 
 namespace carnot {
 
@@ -17,12 +21,19 @@ namespace {
 
 class CarnotB2Draw;
 
-float    g_dt;
-float    g_scale;
-float    g_invScale;
+float       g_dt;
+float       g_scale;
+float       g_invScale;
+float       g_accumulator;          ///< real time not yet simulated
+float       g_alpha;                ///< g_accumulator / g_dt after the last frame
+std::size_t g_maxSubSteps;          ///< max steps per frame
+std::size_t g_stepCount;            ///< steps taken during the last frame
+int         g_velocityIterations;
+int         g_positionIterations;
 
 b2World* g_world;
 CarnotB2Draw* g_draw;
+detail::JobExecutor* g_executor;
 CollisionListener* g_listener;
 
 class CarnotB2Draw : public b2Draw {
@@ -85,6 +96,8 @@ public:
 
 } // namespace
 
+/// Buffers Box2D contact events until the step is done. The world reports them
+/// on this thread in contact list order, even when stepping on the JobSystem.
 class CollisionListener : public b2ContactListener {
 public:
 
@@ -139,6 +152,47 @@ void setDeltaTime(float dt) {
     g_dt = dt;
 }
 
+float getDeltaTime() {
+    return g_dt;
+}
+
+void setMaxSubSteps(std::size_t steps) {
+    g_maxSubSteps = steps > 0 ? steps : 1;
+}
+
+std::size_t getMaxSubSteps() {
+    return g_maxSubSteps;
+}
+
+void setIterations(int velocityIterations, int positionIterations) {
+    g_velocityIterations = velocityIterations;
+    g_positionIterations = positionIterations;
+}
+
+int getVelocityIterations() {
+    return g_velocityIterations;
+}
+
+int getPositionIterations() {
+    return g_positionIterations;
+}
+
+float getAlpha() {
+    return g_alpha;
+}
+
+std::size_t getStepCount() {
+    return g_stepCount;
+}
+
+void setMultithreaded(bool multithreaded) {
+    g_world->SetTaskExecutor(multithreaded ? g_executor : nullptr);
+}
+
+bool isMultithreaded() {
+    return g_world->GetTaskExecutor() != nullptr;
+}
+
 void setGravity(const Vector2f &g) {
     g_world->SetGravity(b2Vec2(g.x * g_scale, g.y * g_scale));
     for (auto body = g_world->GetBodyList(); body; body = body->GetNext()) {
@@ -162,20 +216,51 @@ void init()
     g_dt       = 1.0f / 60.0f;
     g_scale    = 0.010f;
     g_invScale = 100.0f;
+    g_accumulator = 0.0f;
+    g_alpha       = 0.0f;
+    g_maxSubSteps = 5;
+    g_stepCount   = 0;
+    g_velocityIterations = 6;
+    g_positionIterations = 2;
     g_world = new b2World(b2Vec2(0.0f, 981.0f * g_scale));
     g_draw  = new CarnotB2Draw();
     g_listener = new CollisionListener();
+    g_executor = new carnot::detail::JobExecutor(Engine::jobs());
     				
     g_draw->SetFlags(b2Draw::e_shapeBit | b2Draw::e_jointBit | b2Draw::e_pairBit | b2Draw::e_centerOfMassBit | b2Draw::e_particleBit);
     g_world->SetDebugDraw(g_draw);
     g_world->SetContactListener(g_listener);
+    g_world->SetTaskExecutor(g_executor);
 
 }
 
 void update() {
     static auto physicsID = Debug::gizmoId("Physics");
-    g_world->Step(g_dt, 6, 2);
-    g_listener->processCollisions();
+    // step at a fixed rate, decoupled from the frame rate
+    g_accumulator += Engine::deltaTime();
+    g_stepCount = 0;
+    while (g_accumulator >= g_dt && g_stepCount < g_maxSubSteps) {
+        // remember poses so RigidBodys can interpolate from them
+        for (auto body = g_world->GetBodyList(); body; body = body->GetNext()) {
+            auto rb = static_cast<RigidBody*>(body->GetUserData());
+            if (rb && body->IsAwake())
+                rb->storePreviousPose();
+        }
+        g_world->Step(g_dt, g_velocityIterations, g_positionIterations);
+        g_listener->processCollisions();
+        g_accumulator -= g_dt;
+        g_stepCount++;
+    }
+    // too far behind to catch up, so drop the backlog rather than spiral
+    if (g_accumulator >= g_dt)
+        g_accumulator = std::fmod(g_accumulator, g_dt);
+    g_alpha = g_accumulator / g_dt;
+    // write moving bodies back to their Transforms in a single pass
+    for (auto body = g_world->GetBodyList(); body; body = body->GetNext()) {
+        auto rb = static_cast<RigidBody*>(body->GetUserData());
+        if (rb && body->IsActive() && (body->IsAwake() || rb->m_syncPending))
+            rb->syncTransform();
+    }
     if (Debug::gizmoActive(physicsID))
         g_world->DrawDebugData();
 }
@@ -184,6 +269,7 @@ void shutdown() {
     delete g_draw;
     delete g_world;
     delete g_listener;
+    delete g_executor;
 }
 
 PhysicsWorld* world() {
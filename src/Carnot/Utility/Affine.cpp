@@ -0,0 +1,206 @@
+#include <Utility/Affine.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CARNOT_AFFINE_SSE
+    #include <emmintrin.h>
+#endif
+
+// AVX is used when the CPU supports it, without requiring it at build time
+#if defined(CARNOT_AFFINE_SSE) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+    #define CARNOT_AFFINE_AVX
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define CARNOT_TARGET_AVX
+    #else
+        #define CARNOT_TARGET_AVX __attribute__((target("avx")))
+    #endif
+#endif
+
+namespace carnot {
+
+#ifdef CARNOT_AFFINE_AVX
+
+namespace {
+
+bool detectAvx() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    // the OS must also save the ymm registers
+    return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx");
+#endif
+}
+
+bool hasAvx() {
+    static const bool s_avx = detectAvx();
+    return s_avx;
+}
+
+/// Transforms points four at a time and returns the number transformed
+CARNOT_TARGET_AVX std::size_t transformPointsAvx(const float* m, const float* src, float* dst, std::size_t count) {
+    // [x0 y0 x1 y1 | x2 y2 x3 y3]
+    const __m256 ac8 = _mm256_setr_ps(m[0], m[2], m[0], m[2], m[0], m[2], m[0], m[2]);
+    const __m256 bd8 = _mm256_setr_ps(m[1], m[3], m[1], m[3], m[1], m[3], m[1], m[3]);
+    const __m256 t8  = _mm256_setr_ps(m[4], m[5], m[4], m[5], m[4], m[5], m[4], m[5]);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256 v  = _mm256_loadu_ps(src + 2 * i);
+        __m256 xx = _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 0, 0));
+        __m256 yy = _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm256_storeu_ps(dst + 2 * i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ac8, xx), _mm256_mul_ps(bd8, yy)), t8));
+    }
+    return i;
+}
+
+} // private namespace
+
+#endif
+
+const Affine Affine::Identity;
+
+Affine::Affine(const Matrix3x3& matrix) {
+    // SFML stores a column-major 4x4 matrix
+    const float* m = matrix.getMatrix();
+    m_matrix[0] = m[0];  m_matrix[1] = m[4];
+    m_matrix[2] = m[1];  m_matrix[3] = m[5];
+    m_matrix[4] = m[12]; m_matrix[5] = m[13];
+}
+
+Matrix3x3 Affine::toMatrix3x3() const {
+    return Matrix3x3(m_matrix[0], m_matrix[1], m_matrix[4],
+                     m_matrix[2], m_matrix[3], m_matrix[5],
+                     0.f,         0.f,         1.f);
+}
+
+Affine Affine::getInverse() const {
+    float det = m_matrix[0] * m_matrix[3] - m_matrix[1] * m_matrix[2];
+    if (det == 0.f)
+        return Identity;
+    float invDet = 1.f / det;
+    Affine inv;
+#ifdef CARNOT_AFFINE_SSE
+    // [a b c d] -> [d -b -c a] / det
+    __m128 m = _mm_loadu_ps(m_matrix);
+    __m128 r = _mm_mul_ps(_mm_shuffle_ps(m, m, _MM_SHUFFLE(0, 2, 1, 3)), _mm_setr_ps(invDet, -invDet, -invDet, invDet));
+    // t' = -(R * t)
+    __m128 t = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(m_matrix + 4));
+    __m128 p = _mm_mul_ps(r, _mm_movelh_ps(t, t));
+    __m128 s = _mm_add_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 1, 2, 0)), _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 0, 3, 1)));
+    s = _mm_sub_ps(_mm_setzero_ps(), s);
+    _mm_storeu_ps(inv.m_matrix, r);
+    _mm_storel_pi(reinterpret_cast<__m64*>(inv.m_matrix + 4), s);
+#else
+    inv.m_matrix[0] =  m_matrix[3] * invDet;
+    inv.m_matrix[1] = -m_matrix[1] * invDet;
+    inv.m_matrix[2] = -m_matrix[2] * invDet;
+    inv.m_matrix[3] =  m_matrix[0] * invDet;
+    inv.m_matrix[4] = -(inv.m_matrix[0] * m_matrix[4] + inv.m_matrix[1] * m_matrix[5]);
+    inv.m_matrix[5] = -(inv.m_matrix[2] * m_matrix[4] + inv.m_matrix[3] * m_matrix[5]);
+#endif
+    return inv;
+}
+
+Affine& Affine::combine(const Affine& other) {
+#ifdef CARNOT_AFFINE_SSE
+    __m128 a = _mm_loadu_ps(m_matrix);
+    __m128 b = _mm_loadu_ps(other.m_matrix);
+    // [a b c d] * [a' b' c' d']
+    __m128 r = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 0, 0)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 1, 0))),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 2, 3, 2))));
+    // [a b c d] * t' + t
+    __m128 t  = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(m_matrix + 4));
+    __m128 t2 = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(other.m_matrix + 4));
+    __m128 p  = _mm_mul_ps(a, _mm_movelh_ps(t2, t2));
+    __m128 s  = _mm_add_ps(_mm_add_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 1, 2, 0)), _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 0, 3, 1))), t);
+    _mm_storeu_ps(m_matrix, r);
+    _mm_storel_pi(reinterpret_cast<__m64*>(m_matrix + 4), s);
+#else
+    const float* a = m_matrix;
+    const float* b = other.m_matrix;
+    float r[6];
+    r[0] = a[0] * b[0] + a[1] * b[2];
+    r[1] = a[0] * b[1] + a[1] * b[3];
+    r[2] = a[2] * b[0] + a[3] * b[2];
+    r[3] = a[2] * b[1] + a[3] * b[3];
+    r[4] = a[0] * b[4] + a[1] * b[5] + a[4];
+    r[5] = a[2] * b[4] + a[3] * b[5] + a[5];
+    std::copy(r, r + 6, m_matrix);
+#endif
+    return *this;
+}
+
+Affine& Affine::translate(float x, float y) {
+    return combine(Affine(1.f, 0.f, x, 0.f, 1.f, y));
+}
+
+Affine& Affine::rotate(float angle) {
+    float rad = angle * 3.141592654f / 180.f;
+    float cos = std::cos(rad);
+    float sin = std::sin(rad);
+    return combine(Affine(cos, -sin, 0.f, sin, cos, 0.f));
+}
+
+Affine& Affine::scale(float scaleX, float scaleY) {
+    return combine(Affine(scaleX, 0.f, 0.f, 0.f, scaleY, 0.f));
+}
+
+FloatRect Affine::transformRect(const FloatRect& rect) const {
+    const Vector2f points[] = {
+        transformPoint(rect.left, rect.top),
+        transformPoint(rect.left, rect.top + rect.height),
+        transformPoint(rect.left + rect.width, rect.top),
+        transformPoint(rect.left + rect.width, rect.top + rect.height)
+    };
+    float left = points[0].x, top = points[0].y, right = points[0].x, bottom = points[0].y;
+    for (int i = 1; i < 4; ++i) {
+        left   = std::min(left,   points[i].x);
+        right  = std::max(right,  points[i].x);
+        top    = std::min(top,    points[i].y);
+        bottom = std::max(bottom, points[i].y);
+    }
+    return FloatRect(left, top, right - left, bottom - top);
+}
+
+void Affine::transformPoints(const Vector2f* in, Vector2f* out, std::size_t count) const {
+    const float a = m_matrix[0], b = m_matrix[1], c = m_matrix[2], d = m_matrix[3], tx = m_matrix[4], ty = m_matrix[5];
+    const float* src = &in[0].x;
+    float* dst = &out[0].x;
+    std::size_t i = 0;
+#ifdef CARNOT_AFFINE_AVX
+    if (hasAvx())
+        i = transformPointsAvx(m_matrix, src, dst, count);
+#endif
+#ifdef CARNOT_AFFINE_SSE
+    // two points per iteration: [x0 y0 x1 y1]
+    const __m128 ac4 = _mm_setr_ps(a, c, a, c);
+    const __m128 bd4 = _mm_setr_ps(b, d, b, d);
+    const __m128 t4  = _mm_setr_ps(tx, ty, tx, ty);
+    for (; i + 2 <= count; i += 2) {
+        __m128 v  = _mm_loadu_ps(src + 2 * i);
+        __m128 xx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 yy = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm_storeu_ps(dst + 2 * i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ac4, xx), _mm_mul_ps(bd4, yy)), t4));
+    }
+#endif
+    for (; i < count; ++i) {
+        float x = src[2 * i], y = src[2 * i + 1];
+        dst[2 * i]     = a * x + b * y + tx;
+        dst[2 * i + 1] = c * x + d * y + ty;
+    }
+}
+
+void Affine::transformPoints(const std::vector<Vector2f>& in, std::vector<Vector2f>& out) const {
+    out.resize(in.size());
+    if (!in.empty())
+        transformPoints(in.data(), out.data(), in.size());
+}
+
+} // namespace carnot
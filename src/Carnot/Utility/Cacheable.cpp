@@ -1,5 +1,6 @@
 #include <Utility/Cacheable.hpp>
 #include <Utility/Print.hpp>
+#include <algorithm>
 #include <cassert>
 
 namespace carnot
@@ -7,11 +8,27 @@ namespace carnot
     
 Cacheable::Cacheable(bool stale) :
     m_age(0),
-    m_stale(stale)
+    m_stale(stale),
+    m_nextWatcher(0)
 {
 
 }
 
+Cacheable::Cacheable(const Cacheable& other) :
+    m_age(other.m_age),
+    m_stale(other.m_stale),
+    m_nextWatcher(0)
+{
+
+}
+
+Cacheable& Cacheable::operator=(const Cacheable& other) {
+    m_age = other.m_age;
+    m_stale = other.m_stale;
+    notifyWatchers();
+    return *this;
+}
+
 std::size_t Cacheable::cacheAge() const {
     return m_age;
 }
@@ -26,6 +43,17 @@ bool Cacheable::cacheCurrent(std::size_t& age) const {
     }
 }
 
+std::size_t Cacheable::watchCache(std::function<void()> callback) const {
+    m_watchers.emplace_back(m_nextWatcher, std::move(callback));
+    return m_nextWatcher++;
+}
+
+void Cacheable::unwatchCache(std::size_t id) const {
+    auto it = std::find_if(m_watchers.begin(), m_watchers.end(), [id](const auto& watcher) { return watcher.first == id; });
+    if (it != m_watchers.end())
+        m_watchers.erase(it);
+}
+
 void Cacheable::updateCacheIfStale() const {
     if (m_stale) {
         onCacheUpdate();
@@ -39,7 +67,16 @@ void Cacheable::onCacheUpdate() const {
 }
 
 void Cacheable::makeCacheStale() const {
-    m_stale = true;
+    // watchers only hear of the first change after each update
+    if (!m_stale) {
+        m_stale = true;
+        notifyWatchers();
+    }
+}
+
+void Cacheable::notifyWatchers() const {
+    for (std::size_t i = 0; i < m_watchers.size(); ++i)
+        m_watchers[i].second();
 }
 
 } // carnot
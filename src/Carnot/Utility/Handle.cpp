@@ -0,0 +1,102 @@
+#include <Utility/Handle.hpp>
+#include <vector>
+#include <mutex>
+
+namespace carnot {
+
+//==============================================================================
+// SLOT TABLE
+//==============================================================================
+
+namespace {
+
+constexpr std::uint32_t BLOCK_SIZE = 4096;            ///< slots per block
+constexpr std::uint32_t NO_SLOT    = UINT32_MAX;      ///< end of the free list
+
+/// Generational slot table backing all Handles. Slots are allocated in fixed
+/// size blocks so their addresses are stable, and released slots are recycled
+/// through an intrusive free list. Acquire and release are locked since
+/// Coroutines may be started from parallel updates.
+struct SlotTable {
+    std::mutex mutex;
+    std::vector<detail::HandleSlot*> blocks;
+    std::uint32_t size     = 0;       ///< number of slots ever allocated
+    std::uint32_t freeHead = NO_SLOT; ///< first released slot
+    std::size_t   alive    = 0;       ///< number of slots in use
+
+    detail::HandleSlot* acquire(std::uint32_t& index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeHead != NO_SLOT) {
+            index = freeHead;
+            detail::HandleSlot* slot = at(index);
+            freeHead = slot->nextFree;
+            alive++;
+            return slot;
+        }
+        if (size % BLOCK_SIZE == 0) {
+            auto block = new detail::HandleSlot[BLOCK_SIZE];
+            for (std::uint32_t i = 0; i < BLOCK_SIZE; ++i)
+                block[i] = {0, NO_SLOT};
+            blocks.push_back(block);
+        }
+        index = size++;
+        alive++;
+        return at(index);
+    }
+
+    void invalidate(detail::HandleSlot* slot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot->generation++;
+    }
+
+    void release(detail::HandleSlot* slot, std::uint32_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot->generation++;
+        slot->nextFree = freeHead;
+        freeHead = index;
+        alive--;
+    }
+
+    detail::HandleSlot* at(std::uint32_t index) {
+        return &blocks[index / BLOCK_SIZE][index % BLOCK_SIZE];
+    }
+};
+
+/// Leaked so that Tracked objects destroyed during static destruction are safe
+SlotTable& table() {
+    static SlotTable* s_table = new SlotTable();
+    return *s_table;
+}
+
+} // private namespace
+
+//==============================================================================
+// TRACKED
+//==============================================================================
+
+Tracked::Tracked() {
+    m_handleSlot = table().acquire(m_handleIndex);
+}
+
+Tracked::Tracked(const Tracked&) :
+    Tracked()
+{ }
+
+Tracked& Tracked::operator=(const Tracked&) {
+    return *this;
+}
+
+Tracked::~Tracked() {
+    table().release(m_handleSlot, m_handleIndex);
+}
+
+void Tracked::invalidateHandles() {
+    // the slot is released by ~Tracked, which bumps the generation again
+    table().invalidate(m_handleSlot);
+}
+
+std::size_t Tracked::getTrackedCount() {
+    return table().alive;
+}
+
+} // namespace carnot
@@ -0,0 +1,121 @@
+#include <Utility/PoolAllocator.hpp>
+#include <algorithm>
+#include <cassert>
+#include <new>
+#if defined(__GNUC__)
+    #include <cxxabi.h>
+    #include <cstdlib>
+#endif
+
+namespace carnot {
+
+//==============================================================================
+// GLOBALS
+//==============================================================================
+
+namespace {
+
+constexpr std::size_t MIN_CHUNK_BLOCKS = 64;   ///< blocks in the first chunk
+constexpr std::size_t MAX_CHUNK_BLOCKS = 4096; ///< maximum blocks per chunk
+
+/// All live pools, for statistics (leaked so pools may outlive static destruction)
+std::vector<MemoryPool*>& pools() {
+    static std::vector<MemoryPool*>* s_pools = new std::vector<MemoryPool*>();
+    return *s_pools;
+}
+
+/// Makes a readable name from a typeid name
+std::string demangle(const std::string& name) {
+#if defined(__GNUC__)
+    int status = 0;
+    char* readable = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (status == 0 && readable) {
+        std::string result(readable);
+        std::free(readable);
+        return result;
+    }
+#endif
+    return name;
+}
+
+} // private namespace
+
+//==============================================================================
+// MEMORY POOL
+//==============================================================================
+
+MemoryPool::MemoryPool(const std::string& name) :
+    m_name(demangle(name)),
+    m_blockSize(0),
+    m_alignment(0),
+    m_capacity(0),
+    m_used(0),
+    m_peak(0),
+    m_free(nullptr)
+{
+    pools().push_back(this);
+}
+
+MemoryPool::~MemoryPool() {
+    auto& all = pools();
+    all.erase(std::remove(all.begin(), all.end(), this), all.end());
+    for (auto chunk : m_chunks)
+        ::operator delete(chunk, std::align_val_t(m_alignment));
+}
+
+void* MemoryPool::allocate(std::size_t size, std::size_t alignment) {
+    if (m_blockSize == 0) {
+        // first allocation fixes the block layout
+        m_alignment = std::max(alignment, alignof(void*));
+        m_blockSize = std::max(size, sizeof(void*));
+        m_blockSize = (m_blockSize + m_alignment - 1) / m_alignment * m_alignment;
+    }
+    assert(size <= m_blockSize && alignment <= m_alignment);
+    if (m_free == nullptr)
+        grow();
+    void* block = m_free;
+    m_free = *static_cast<void**>(block);
+    m_peak = std::max(m_peak, ++m_used);
+    return block;
+}
+
+void MemoryPool::deallocate(void* block) {
+    *static_cast<void**>(block) = m_free;
+    m_free = block;
+    m_used--;
+}
+
+void MemoryPool::grow() {
+    std::size_t blocks = std::min(std::max(m_capacity, MIN_CHUNK_BLOCKS), MAX_CHUNK_BLOCKS);
+    char* chunk = static_cast<char*>(::operator new(blocks * m_blockSize, std::align_val_t(m_alignment)));
+    m_chunks.push_back(chunk);
+    m_capacity += blocks;
+    // thread the new blocks in address order so they are handed out sequentially
+    for (std::size_t i = blocks; i-- > 0; ) {
+        void* block = chunk + i * m_blockSize;
+        *static_cast<void**>(block) = m_free;
+        m_free = block;
+    }
+}
+
+PoolStats MemoryPool::getStats() const {
+    PoolStats stats;
+    stats.name          = m_name;
+    stats.blockSize     = m_blockSize;
+    stats.capacity      = m_capacity;
+    stats.used          = m_used;
+    stats.peak          = m_peak;
+    stats.chunks        = m_chunks.size();
+    stats.fragmentation = m_capacity > 0 ? (float)(m_capacity - m_used) / (float)m_capacity : 0.0f;
+    return stats;
+}
+
+std::vector<PoolStats> MemoryPool::getAllStats() {
+    std::vector<PoolStats> stats;
+    for (auto pool : pools())
+        stats.push_back(pool->getStats());
+    std::sort(stats.begin(), stats.end(), [](const PoolStats& a, const PoolStats& b) { return a.name < b.name; });
+    return stats;
+}
+
+} // namespace carnot
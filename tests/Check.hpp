@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdio>
+
+/// Shared assertions for the tests, which print the failed condition and line
+
+namespace carnot {
+namespace test {
+
+/// Set once a CHECK_FRAME fails, for main to return non-zero after Engine::run
+inline bool& failed() {
+    static bool s_failed = false;
+    return s_failed;
+}
+
+} // namespace test
+} // namespace carnot
+
+/// Returns 1 from the enclosing function (main or a test returning int) if cond is false
+#define CHECK(cond) \
+    if (!(cond)) { std::printf("FAILED: %s (line %d)\n", #cond, __LINE__); return 1; }
+
+/// Marks the test failed, stops the Engine and returns from the enclosing
+/// void function (e.g. an update) if cond is false
+#define CHECK_FRAME(cond) \
+    if (!(cond)) { std::printf("FAILED: %s (line %d)\n", #cond, __LINE__); carnot::test::failed() = true; carnot::Engine::stop(); return; }
@@ -0,0 +1,93 @@
+// Verifies the SIMD paths of Affine (inverse, combine and batch point
+// transforms) against scalar reference implementations
+
+#include <Utility/Affine.hpp>
+#include <Check.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace carnot;
+
+bool near(float a, float b) {
+    return std::abs(a - b) <= 1e-4f * std::max(1.0f, std::max(std::abs(a), std::abs(b)));
+}
+
+bool near(const Affine& a, const float* b) {
+    for (int i = 0; i < 6; ++i) {
+        if (!near(a.getMatrix()[i], b[i]))
+            return false;
+    }
+    return true;
+}
+
+/// {a, b, c, d, tx, ty} of the inverse of m
+void inverse(const float* m, float* r) {
+    float invDet = 1.f / (m[0] * m[3] - m[1] * m[2]);
+    r[0] =  m[3] * invDet;
+    r[1] = -m[1] * invDet;
+    r[2] = -m[2] * invDet;
+    r[3] =  m[0] * invDet;
+    r[4] = -(r[0] * m[4] + r[1] * m[5]);
+    r[5] = -(r[2] * m[4] + r[3] * m[5]);
+}
+
+/// {a, b, c, d, tx, ty} of m * n
+void combine(const float* m, const float* n, float* r) {
+    r[0] = m[0] * n[0] + m[1] * n[2];
+    r[1] = m[0] * n[1] + m[1] * n[3];
+    r[2] = m[2] * n[0] + m[3] * n[2];
+    r[3] = m[2] * n[1] + m[3] * n[3];
+    r[4] = m[0] * n[4] + m[1] * n[5] + m[4];
+    r[5] = m[2] * n[4] + m[3] * n[5] + m[5];
+}
+
+int main() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> value(-10, 10);
+    auto random = [&]() {
+        return Affine(value(rng), value(rng), value(rng), value(rng), value(rng), value(rng));
+    };
+
+    for (int n = 0; n < 1000; ++n) {
+        Affine A = random();
+        Affine B = random();
+        const float* m = A.getMatrix();
+        float expected[6];
+        // inverse
+        if (std::abs(m[0] * m[3] - m[1] * m[2]) > 1e-2f) {
+            inverse(m, expected);
+            CHECK(near(A.getInverse(), expected));
+        }
+        // combine
+        combine(m, B.getMatrix(), expected);
+        CHECK(near(A * B, expected));
+    }
+    // a singular transformation has no inverse
+    Affine singular(1, 2, 3, 2, 4, 5);
+    CHECK(near(singular.getInverse(), Affine::Identity.getMatrix()));
+
+    // batch transforms of every count up to a few SIMD widths, which covers
+    // the AVX, SSE and scalar loops and their remainders
+    Affine A = random();
+    const float* m = A.getMatrix();
+    for (std::size_t count = 0; count < 20; ++count) {
+        std::vector<Vector2f> in(count), out;
+        for (auto& p : in)
+            p = Vector2f(value(rng), value(rng));
+        A.transformPoints(in, out);
+        CHECK(out.size() == count);
+        for (std::size_t i = 0; i < count; ++i) {
+            CHECK(near(out[i].x, m[0] * in[i].x + m[1] * in[i].y + m[4]));
+            CHECK(near(out[i].y, m[2] * in[i].x + m[3] * in[i].y + m[5]));
+        }
+        // in place
+        A.transformPoints(in, in);
+        CHECK(in == out);
+    }
+
+    std::printf("affine ok\n");
+    return 0;
+}
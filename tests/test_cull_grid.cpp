@@ -0,0 +1,146 @@
+// Verifies CullGrid queries against a brute force overlap test as rectangles
+// are inserted, moved and removed, and compares the cost of keeping 100k
+// rectangles culled against a linear scan
+
+#include <Graphics/CullGrid.hpp>
+#include <Check.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace carnot;
+
+bool overlaps(const FloatRect& a, const FloatRect& b) {
+    return a.left <= b.left + b.width  && b.left <= a.left + a.width &&
+           a.top  <= b.top  + b.height && b.top  <= a.top  + a.height;
+}
+
+template <typename F>
+double measure(F&& fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main() {
+    const std::size_t count = 100000;
+    const float world = 50000;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos(-world, world);
+    std::uniform_real_distribution<float> size(0, 100);
+
+    std::vector<FloatRect> rects(count);
+    for (auto& r : rects)
+        r = FloatRect(pos(rng), pos(rng), size(rng), size(rng));
+    // a few large and degenerate rectangles
+    rects[0] = FloatRect(-world, -world, 2 * world, 2 * world);
+    rects[1] = FloatRect(10, 10, 500, 0);
+    rects[2] = FloatRect(-5000, 20, 10000, 3);
+
+    CullGrid grid;
+    grid.setCellSize(1920.0f / 8);
+    std::vector<std::uint32_t> keys(count);
+    for (std::size_t i = 0; i < count; ++i)
+        keys[i] = grid.insert(rects[i]);
+    CHECK(grid.size() == count);
+
+    std::vector<FloatRect> views = {
+        FloatRect(-960, -540, 1920, 1080),
+        FloatRect(12345, -20000, 1920, 1080),
+        FloatRect(-40000, 30000, 300, 200),
+        FloatRect(-world, -world, 2 * world, 2 * world), // everything (linear scan)
+        FloatRect(1e7f, 1e7f, 100, 100)                  // far outside
+    };
+    std::vector<bool> removed(count, false);
+    std::vector<std::uint32_t> visible, expected;
+    auto verify = [&]() {
+        for (auto& view : views) {
+            visible.clear();
+            expected.clear();
+            grid.query(view, visible);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!removed[i] && overlaps(rects[i], view))
+                    expected.push_back(keys[i]);
+            }
+            std::sort(visible.begin(), visible.end());
+            std::sort(expected.begin(), expected.end());
+            if (visible != expected)
+                return false;
+        }
+        return true;
+    };
+    CHECK(verify());
+
+    // move some rectangles, across cells and into and out of the large list
+    for (std::size_t i = 3; i < count; i += 7) {
+        rects[i].left += pos(rng) * 0.01f;
+        rects[i].top += pos(rng) * 0.01f;
+        if (i % 5 == 0)
+            rects[i].width = 1000;
+        grid.update(keys[i], rects[i]);
+    }
+    grid.update(keys[0], rects[0] = FloatRect(-30, -30, 60, 60));
+    CHECK(verify());
+    // remove some and reuse their keys
+    for (std::size_t i = 1; i < count; i += 3) {
+        grid.remove(keys[i]);
+        removed[i] = true;
+    }
+    CHECK(grid.size() == count - (count - 1 + 2) / 3);
+    CHECK(verify());
+    for (std::size_t i = 1; i < count; i += 6) {
+        keys[i] = grid.insert(rects[i]);
+        removed[i] = false;
+    }
+    CHECK(verify());
+    // rehash into a different cell size
+    grid.setCellSize(100);
+    CHECK(verify());
+    grid.setCellSize(1920.0f / 8);
+
+    // cost of building the grid, of moving 1% of the rectangles each frame
+    // and of one view query versus testing every rectangle
+    const int frames = 20;
+    FloatRect view(-960, -540, 1920, 1080);
+    double gridBuild = measure([&]() {
+        for (int f = 0; f < frames; ++f) {
+            grid.clear();
+            for (std::size_t i = 0; i < count; ++i)
+                keys[i] = grid.insert(rects[i]);
+        }
+    });
+    double gridUpdate = measure([&]() {
+        for (int f = 0; f < frames; ++f) {
+            for (std::size_t i = f; i < count; i += 100) {
+                rects[i].left += 1;
+                grid.update(keys[i], rects[i]);
+            }
+        }
+    });
+    std::size_t found = 0;
+    double gridQuery = measure([&]() {
+        for (int f = 0; f < frames; ++f) {
+            visible.clear();
+            grid.query(view, visible);
+            found += visible.size();
+        }
+    });
+    double linear = measure([&]() {
+        for (int f = 0; f < frames; ++f) {
+            visible.clear();
+            for (std::size_t i = 0; i < count; ++i) {
+                if (overlaps(rects[i], view))
+                    visible.push_back((std::uint32_t)i);
+            }
+            found += visible.size();
+        }
+    });
+    std::printf("%zu rects: build %.3f ms, update 1%% %.3f ms, query %.3f ms, linear scan %.3f ms per frame (%zu)\n",
+        count, gridBuild / frames, gridUpdate / frames, gridQuery / frames, linear / frames, found);
+
+    std::printf("cull grid ok\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Benchmarks generational Handles against the previous weak_ptr-backed Handle
+
+#include <Utility/Handle.hpp>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace carnot;
+
+struct Cell : public Tracked {
+    float value = 0.0f;
+    void set(float v) { value = v; }
+};
+
+/// Records whether a Handle to itself is still valid while it is destroyed
+struct Probe : public Tracked {
+    ~Probe() { validInDestructor = self.isValid(); }
+    Handle<Probe> self;
+    static bool validInDestructor;
+};
+
+bool Probe::validInDestructor = true;
+
+/// The previous Handle implementation (weak_ptr lock on every access)
+template <typename T>
+struct WeakHandle {
+    WeakHandle(const Ptr<T>& ptr) : wkPtr(ptr) { }
+    T* operator->() const { return wkPtr.lock().get(); }
+    bool isValid() const { return !wkPtr.expired() && wkPtr.lock().get() != nullptr; }
+    WkPtr<T> wkPtr;
+};
+
+template <typename F>
+double measure(F&& fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main() {
+    const std::size_t count = 10000;
+    const std::size_t frames = 500;
+
+    std::vector<Ptr<Cell>> cells;
+    for (std::size_t i = 0; i < count; ++i)
+        cells.push_back(std::make_shared<Cell>());
+
+    std::vector<WeakHandle<Cell>> weakHandles;
+    std::vector<Handle<Cell>> handles;
+    for (auto& cell : cells) {
+        weakHandles.emplace_back(cell);
+        handles.emplace_back(cell);
+    }
+
+    double weakTime = measure([&]() {
+        for (std::size_t f = 0; f < frames; ++f) {
+            for (auto& h : weakHandles) {
+                if (h.isValid())
+                    h->set(h->value + 1.0f);
+            }
+        }
+    });
+
+    double handleTime = measure([&]() {
+        for (std::size_t f = 0; f < frames; ++f) {
+            for (auto& h : handles) {
+                if (h.isValid())
+                    h->set(h->value + 1.0f);
+            }
+        }
+    });
+
+    std::printf("%zu handles x %zu frames (isValid + 2 derefs)\n", count, frames);
+    std::printf("  weak_ptr Handle:     %8.2f ms\n", weakTime);
+    std::printf("  generational Handle: %8.2f ms (%.1fx)\n", handleTime, weakTime / handleTime);
+
+    // invalidation and Ptr round trip
+    Handle<Cell> h = handles[0];
+    Ptr<Cell> p = h.lock();
+    bool roundTrip = p == cells[0];
+    p.reset();
+    cells[0].reset();
+    bool invalidated = !h.isValid() && h.get() == nullptr && !h.lock();
+    cells[1].reset();
+    cells.push_back(std::make_shared<Cell>()); // reuses a released slot
+    bool stale = !handles[1].isValid() && Handle<Cell>(cells.back()).isValid();
+
+    // Handles are invalid before destructors run when deleted through TrackedDelete
+    Ptr<Probe> probe(new Probe(), detail::TrackedDelete());
+    probe->self = Handle<Probe>(probe);
+    probe.reset();
+    bool early = !Probe::validInDestructor;
+
+    std::printf("round trip: %s, invalidation: %s, slot reuse: %s, destruction: %s\n",
+                roundTrip ? "ok" : "FAILED", invalidated ? "ok" : "FAILED", stale ? "ok" : "FAILED", early ? "ok" : "FAILED");
+    return roundTrip && invalidated && stale && early ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+// Verifies that identical Shapes share one cached Mesh and that Meshes are
+// evicted once the last reference is released
+
+#include <Geometry/MeshCache.hpp>
+#include <Geometry/Shape.hpp>
+#include <Geometry/SquareShape.hpp>
+#include <Geometry/CircleShape.hpp>
+#include <Check.hpp>
+#include <cstdio>
+#include <vector>
+
+using namespace carnot;
+
+int main() {
+    std::size_t count = MeshCache::getMeshCount();
+    {
+        SquareShape a(10), b(10), c(20);
+        auto meshA = MeshCache::get(a);
+        auto meshB = MeshCache::get(b);
+        auto meshC = MeshCache::get(c);
+        // identical geometry shares a Mesh, different geometry does not
+        CHECK(meshA == meshB);
+        CHECK(meshA != meshC);
+        CHECK(meshA->indices.size() == 6);
+        CHECK(MeshCache::getMeshCount() == count + 2);
+        // holes are part of the key
+        SquareShape d(10);
+        d.addHole(SquareShape(5));
+        auto meshD = MeshCache::get(d);
+        CHECK(meshD != meshA);
+        CHECK(meshD->contours.size() == 2);
+        // triangulate() expands the cached Mesh
+        CHECK(a.triangulate().size() == meshA->indices.size());
+        // degenerate Shapes get an empty Mesh which is not cached
+        Shape empty;
+        CHECK(MeshCache::get(empty)->indices.empty());
+        CHECK(MeshCache::getMeshCount() == count + 3);
+    }
+    // released Meshes are evicted
+    CHECK(MeshCache::getMeshCount() == count);
+
+    // many identical Shapes triangulate once
+    std::size_t misses = MeshCache::getMissCount();
+    std::vector<Ptr<const Mesh>> meshes;
+    for (int i = 0; i < 1000; ++i)
+        meshes.push_back(MeshCache::get(CircleShape(5, 40)));
+    CHECK(MeshCache::getMissCount() == misses + 1);
+    CHECK(MeshCache::getMeshCount() == count + 1);
+    meshes.clear();
+    CHECK(MeshCache::getMeshCount() == count);
+
+    std::printf("mesh cache ok\n");
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Benchmarks the scalar and SIMD LiquidFun particle kernels, serially and on
+// the JobSystem
+
+#include <Box2D/Box2D.h>
+#include <Box2D/Particle/b2ParticleAssembly.h>
+#include <Carnot/Glue/JobExecutor.inl>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace carnot;
+
+/// Steps a block of particles resting on the ground, returns ms per step
+double simulate(int count, int steps, std::vector<b2Vec2>& positions, b2TaskExecutor* executor = nullptr) {
+    b2World world(b2Vec2(0.0f, -10.0f));
+    world.SetTaskExecutor(executor);
+    b2BodyDef groundDef;
+    b2Body* ground = world.CreateBody(&groundDef);
+    b2PolygonShape groundBox;
+    groundBox.SetAsBox(1000.0f, 1.0f, b2Vec2(0.0f, -1.0f), 0.0f);
+    ground->CreateFixture(&groundBox, 0.0f);
+
+    b2ParticleSystemDef systemDef;
+    systemDef.radius = 0.05f;
+    b2ParticleSystem* system = world.CreateParticleSystem(&systemDef);
+    int side = (int)std::ceil(std::sqrt((float)count));
+    float spacing = 0.75f * 2.0f * systemDef.radius;
+    b2ParticleDef def;
+    for (int i = 0; i < count; ++i) {
+        def.position.Set(spacing * (i % side), 0.05f + spacing * (i / side));
+        system->CreateParticle(def);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < steps; ++i)
+        world.Step(1.0f / 60.0f, 6, 2);
+    auto stop = std::chrono::high_resolution_clock::now();
+    const b2Vec2* p = system->GetPositionBuffer();
+    positions.assign(p, p + system->GetParticleCount());
+    return std::chrono::duration<double, std::milli>(stop - start).count() / steps;
+}
+
+int main() {
+    const char* names[] = { "scalar", "SSE2", "AVX2" };
+    const int counts[] = { 5000, 50000, 200000 };
+    b2SetParticleSimdLevel(b2_particleSimdAvx2);
+    b2ParticleSimdLevel best = b2GetParticleSimdLevel();
+    std::printf("best particle SIMD level: %s\n", names[best]);
+
+    bool identical = true;
+    for (int count : counts) {
+        int steps = count >= 200000 ? 10 : 30;
+        std::vector<b2Vec2> reference, positions;
+        std::printf("%d particles x %d steps\n", count, steps);
+        double scalarTime = 0.0;
+        for (int level = b2_particleSimdNone; level <= best; ++level) {
+            b2SetParticleSimdLevel((b2ParticleSimdLevel)level);
+            double time = simulate(count, steps, level == b2_particleSimdNone ? reference : positions);
+            if (level == b2_particleSimdNone)
+                scalarTime = time;
+            else
+                identical = identical && positions.size() == reference.size() &&
+                    std::memcmp(positions.data(), reference.data(), reference.size() * sizeof(b2Vec2)) == 0;
+            std::printf("  %-6s %8.3f ms/step (%.2fx)\n", names[level], time, scalarTime / time);
+        }
+    }
+    std::printf("identical results: %s\n", identical ? "ok" : "FAILED");
+
+    // chunked reductions sum in a different order than serial, but must be
+    // the same on every run with the same thread count
+    JobSystem jobs(3);
+    detail::JobExecutor executor(jobs);
+    bool deterministic = true;
+    b2SetParticleSimdLevel(best);
+    for (int count : counts) {
+        int steps = count >= 200000 ? 10 : 30;
+        std::vector<b2Vec2> serial, first, second;
+        double serialTime = simulate(count, steps, serial);
+        double time = simulate(count, steps, first, &executor);
+        simulate(count, steps, second, &executor);
+        deterministic = deterministic && first.size() == second.size() &&
+            std::memcmp(first.data(), second.data(), first.size() * sizeof(b2Vec2)) == 0;
+        std::printf("%d particles on %d threads: %8.3f ms/step (%.2fx)\n",
+            count, (int)jobs.getThreadCount(), time, serialTime / time);
+    }
+    std::printf("deterministic threaded results: %s\n", deterministic ? "ok" : "FAILED");
+    return identical && deterministic ? 0 : 1;
+}
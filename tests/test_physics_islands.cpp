@@ -0,0 +1,116 @@
+// Benchmarks stepping a Box2D world serially and on the JobSystem
+
+#include <Box2D/Box2D.h>
+#include <Carnot/Glue/JobExecutor.inl>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace carnot;
+
+/// Runs everything on the calling thread, but through the same code paths as
+/// a multithreaded executor (whose results must not depend on thread count)
+class InlineExecutor : public b2TaskExecutor {
+public:
+    int32 GetThreadCount() const override {
+        return 1;
+    }
+
+    void ParallelFor(int32 count, int32 minChunk, b2ParallelTask* task) override {
+        if (count > 0)
+            task->Execute(0, count, 0);
+    }
+};
+
+/// Hashes the sequence of contact events
+class EventHasher : public b2ContactListener {
+public:
+    void BeginContact(b2Contact* contact) override { mix(1, contact); }
+    void EndContact(b2Contact* contact) override { mix(2, contact); }
+    void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override { mix(3, contact); }
+
+    void mix(std::uint64_t event, b2Contact* contact) {
+        auto a = (std::uint64_t)(std::size_t)contact->GetFixtureA()->GetUserData();
+        auto b = (std::uint64_t)(std::size_t)contact->GetFixtureB()->GetUserData();
+        hash = (hash ^ (event | a << 2 | b << 32)) * 0x100000001B3ull;
+    }
+
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+};
+
+/// Builds many separate piles of boxes, each resting on its own ground, and
+/// connected to a single shared static body by a revolute joint so that
+/// islands running in parallel share static bodies.
+void buildPiles(b2World& world, int piles, int height) {
+    b2BodyDef anchorDef;
+    b2Body* anchor = world.CreateBody(&anchorDef);
+    std::size_t fixtures = 0;
+    b2PolygonShape box;
+    box.SetAsBox(0.5f, 0.5f);
+    b2PolygonShape groundBox;
+    groundBox.SetAsBox(2.0f, 0.5f);
+    for (int p = 0; p < piles; ++p) {
+        float x = 6.0f * p;
+        b2BodyDef groundDef;
+        groundDef.position.Set(x, 0.0f);
+        world.CreateBody(&groundDef)->CreateFixture(&groundBox, 0.0f)->SetUserData((void*)++fixtures);
+        b2Body* below = nullptr;
+        for (int i = 0; i < height; ++i) {
+            b2BodyDef def;
+            def.type = b2_dynamicBody;
+            def.position.Set(x + 0.05f * (i % 3), 1.0f + 1.05f * i);
+            b2Body* body = world.CreateBody(&def);
+            body->CreateFixture(&box, 1.0f)->SetUserData((void*)++fixtures);
+            below = body;
+        }
+        b2RevoluteJointDef jd;
+        jd.Initialize(anchor, below, below->GetPosition());
+        jd.enableLimit = true;
+        jd.lowerAngle = -0.1f;
+        jd.upperAngle = 0.1f;
+        world.CreateJoint(&jd);
+    }
+}
+
+double simulate(b2TaskExecutor* executor, int steps, std::vector<b2Vec2>& positions, std::uint64_t& events) {
+    b2World world(b2Vec2(0.0f, -10.0f));
+    EventHasher listener;
+    world.SetTaskExecutor(executor);
+    world.SetContactListener(&listener);
+    buildPiles(world, 400, 10);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < steps; ++i)
+        world.Step(1.0f / 60.0f, 6, 2);
+    auto stop = std::chrono::high_resolution_clock::now();
+    positions.clear();
+    for (b2Body* b = world.GetBodyList(); b; b = b->GetNext())
+        positions.push_back(b->GetPosition());
+    events = listener.hash;
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main() {
+    const int steps = 300;
+    JobSystem jobs;
+    detail::JobExecutor executor(jobs);
+    InlineExecutor inlineExecutor;
+
+    std::vector<b2Vec2> serial, inlined, parallel;
+    std::uint64_t serialEvents, inlinedEvents, parallelEvents;
+    double serialTime   = simulate(nullptr, steps, serial, serialEvents);
+    double inlinedTime  = simulate(&inlineExecutor, steps, inlined, inlinedEvents);
+    double parallelTime = simulate(&executor, steps, parallel, parallelEvents);
+
+    std::printf("4000 bodies in 400 islands x %d steps\n", steps);
+    std::printf("  serial:            %8.2f ms\n", serialTime);
+    std::printf("  inline executor:   %8.2f ms\n", inlinedTime);
+    std::printf("  parallel (%2zu thr): %8.2f ms (%.1fx)\n", jobs.getThreadCount(), parallelTime, serialTime / parallelTime);
+
+    bool identical = inlined.size() == parallel.size() &&
+        std::memcmp(inlined.data(), parallel.data(), inlined.size() * sizeof(b2Vec2)) == 0;
+    bool sameEvents = inlinedEvents == parallelEvents;
+    std::printf("identical results: %s, identical events: %s\n", identical ? "ok" : "FAILED", sameEvents ? "ok" : "FAILED");
+    return identical && sameEvents ? 0 : 1;
+}
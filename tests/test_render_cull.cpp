@@ -0,0 +1,97 @@
+// Verifies that Engine::render draws exactly the Renderers overlapping the
+// View as Renderers move, are disabled and are destroyed, and times the
+// culling of 100k static Renderers, which only changed Renderers should cost
+
+#include <carnot>
+#include <Check.hpp>
+#include <cstdio>
+
+using namespace carnot;
+
+namespace {
+constexpr int g_side    = 317;   ///< Renderers per row and column (about 100k)
+constexpr float g_space = 40.0f; ///< distance between neighbouring Renderers
+constexpr std::size_t g_warmup = 5;
+constexpr std::size_t g_frames = 100;
+
+bool overlaps(const FloatRect& a, const FloatRect& b) {
+    return a.left <= b.left + b.width  && b.left <= a.left + a.width &&
+           a.top  <= b.top  + b.height && b.top  <= a.top  + a.height;
+}
+}
+
+class Tester : public GameObject {
+public:
+
+    /// Number of enabled Renderers overlapping the View, found by brute force
+    std::size_t countVisible() {
+        auto& view = Engine::getView(0);
+        FloatRect rect(view.getCenter() - 0.5f * view.getSize(), view.getSize());
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < getChildCount(); ++i) {
+            auto renderer = getChild(i)->getComponent<ShapeRenderer>();
+            if (renderer->isEnabled() && overlaps(renderer->getWorldBounds(), rect))
+                count++;
+        }
+        return count;
+    }
+
+    void update() {
+        std::size_t frame = m_frame++;
+        if (frame == 0) {
+            Engine::getView(0).setCenter(0, 0);
+            for (int y = 0; y < g_side; ++y) {
+                for (int x = 0; x < g_side; ++x) {
+                    auto child = makeChild<GameObject>();
+                    child->transform.setPosition(g_space * (x - g_side / 2), g_space * (y - g_side / 2));
+                    child->addComponent<ShapeRenderer>()->setShape(SquareShape(20));
+                }
+            }
+        }
+        else if (frame == 2) {
+            CHECK_FRAME(Renderer::getDrawnCount() == countVisible());
+            CHECK_FRAME(Renderer::getDrawnCount() + Renderer::getCulledCount() == getChildCount());
+            m_visible = Renderer::getDrawnCount();
+        }
+        else if (frame < 2 + g_warmup) {
+        }
+        else if (frame < 2 + g_warmup + g_frames) {
+            // nothing moves, so culling only queries the grid
+            m_cullingTime += Renderer::getCullingTime();
+            CHECK_FRAME(Renderer::getDrawnCount() == m_visible);
+        }
+        else if (frame == 2 + g_warmup + g_frames) {
+            std::printf("culling %zu static Renderers: %.4f ms per frame (%zu drawn)\n",
+                getChildCount(), m_cullingTime / g_frames, m_visible);
+            // move a Renderer into view, hide one and destroy one
+            getChild(0)->transform.setPosition(0, 0);
+            getChild(getChildCount() / 2)->getComponent<ShapeRenderer>()->setEnabled(false);
+            getChild(getChildCount() / 2 + 1)->destroy();
+        }
+        else if (frame == 3 + g_warmup + g_frames) {
+            CHECK_FRAME(Renderer::getDrawnCount() == countVisible());
+            transform.move(g_space / 2, g_space / 2);
+            // edits to a Shape held by the ShapeRenderer are picked up too
+            getChild(1)->getComponent<ShapeRenderer>()->getShape()->scale(1e4f, 1e4f);
+        }
+        else {
+            CHECK_FRAME(Renderer::getDrawnCount() == countVisible());
+            Engine::stop();
+        }
+    }
+
+private:
+    std::size_t m_frame = 0;
+    std::size_t m_visible = 0;
+    double m_cullingTime = 0;
+};
+
+int main(int argc, char const *argv[]) {
+    Engine::init(500, 500);
+    Engine::makeRoot<Tester>();
+    Engine::run();
+    if (test::failed())
+        return 1;
+    std::printf("render cull ok\n");
+    return 0;
+}
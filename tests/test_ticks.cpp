@@ -0,0 +1,121 @@
+// Verifies that GameObjects and Components made from update() can be read
+// back immediately and start ticking on the next frame, and that spawning,
+// despawning, enabling and reordering objects keeps updates in tree order
+
+#include <carnot>
+#include <Check.hpp>
+#include <cstdio>
+
+using namespace carnot;
+
+namespace {
+std::vector<int> g_order; ///< tags of Counters in the order they updated
+}
+
+class Counter : public Component {
+public:
+    Counter(GameObject& gameObject, int _tag) : Component(gameObject), tag(_tag) { }
+    void start() { started++; }
+    void update() { updates++; g_order.push_back(tag); }
+    int tag;
+    int started = 0;
+    int updates = 0;
+};
+
+/// Runs one step per frame. The root updates before its children, so each
+/// step sees the order in which Counters updated during the previous frame.
+class Tester : public GameObject {
+public:
+
+    void update() {
+        std::vector<int> order;
+        order.swap(g_order);
+        std::size_t frame = m_frame++;
+        if (frame == 0) {
+            // a child and its Components made during update() are usable at once
+            auto go = makeChild<GameObject>();
+            go->transform.setPosition(10, 20);
+            go->addComponent<ShapeRenderer>();
+            CHECK_FRAME(go->getComponent<ShapeRenderer>().isValid());
+            go->getComponent<ShapeRenderer>()->setColor(Reds::Red);
+            CHECK_FRAME(go->getComponent<ShapeRenderer>()->getColor() == Reds::Red);
+            go->addComponent<Counter>(1);
+            CHECK_FRAME(go->getComponent<Counter>().isValid());
+            CHECK_FRAME(go->getComponentCount() == 3);
+            // and so is a grandchild made on the new child
+            auto grandchild = go->makeChild<GameObject>();
+            grandchild->addComponent<Counter>(2);
+            CHECK_FRAME(go->getChildCount() == 1);
+            CHECK_FRAME(grandchild->getComponent<Counter>().isValid());
+            m_child = go;
+            // the new child is attached once the frame's commands are applied
+            CHECK_FRAME(getChildCount() == 0);
+        }
+        else if (frame == 1) {
+            CHECK_FRAME(order.empty());
+            CHECK_FRAME(getChildCount() == 1);
+            CHECK_FRAME(m_child.isValid());
+            CHECK_FRAME(m_child->transform.getPosition() == Vector2f(10, 20));
+            CHECK_FRAME(m_child->getComponent<Counter>()->started == 0);
+            // Components added to a ticking GameObject are attached after update
+            m_child->addComponent<Counter>(3);
+            CHECK_FRAME(m_child->getComponentCount() == 3);
+            m_pool = std::make_unique<ObjectPool<GameObject>>(getHandle());
+        }
+        else if (frame == 2) {
+            CHECK_FRAME((order == std::vector<int>{1, 2}));
+            CHECK_FRAME(m_child->getComponent<Counter>()->started == 1);
+            CHECK_FRAME(m_child->getComponent<Counter>()->updates == 1);
+            CHECK_FRAME(m_child->getComponentCount() == 4);
+            CHECK_FRAME(m_child->getComponents<Counter>().size() == 2);
+            for (int i = 0; i < 4; ++i)
+                m_pool->spawn()->addComponent<Counter>(10 + i);
+        }
+        else if (frame == 3) {
+            // children update after their parent, in sibling order
+            CHECK_FRAME((order == std::vector<int>{1, 3, 2}));
+            CHECK_FRAME(getChildCount() == 5);
+        }
+        else if (frame == 4) {
+            CHECK_FRAME((order == std::vector<int>{1, 3, 2, 10, 11, 12, 13}));
+            m_pool->despawn(getChild(2));
+            m_pool->despawn(getChild(4));
+        }
+        else if (frame == 5) {
+            CHECK_FRAME(m_pool->getPooledCount() == 2);
+            m_pool->spawn();
+            m_pool->spawn();
+            m_child->setEnabled(false);
+        }
+        else if (frame == 6) {
+            // despawned objects stopped updating
+            CHECK_FRAME((order == std::vector<int>{1, 3, 2, 10, 12}));
+            m_child->setEnabled(true);
+            makeChildLast(0);
+        }
+        else if (frame == 7) {
+            // respawned objects resume in tree order, disabled subtrees are skipped
+            CHECK_FRAME((order == std::vector<int>{10, 11, 12, 13}));
+        }
+        else if (frame == 8) {
+            CHECK_FRAME((order == std::vector<int>{10, 11, 12, 13, 1, 3, 2}));
+            m_pool.reset();
+            Engine::stop();
+        }
+    }
+
+private:
+    std::size_t m_frame = 0;
+    Handle<GameObject> m_child;
+    std::unique_ptr<ObjectPool<GameObject>> m_pool;
+};
+
+int main(int argc, char const *argv[]) {
+    Engine::init(500, 500);
+    Engine::makeRoot<Tester>();
+    Engine::run();
+    if (test::failed())
+        return 1;
+    std::printf("ticks ok\n");
+    return 0;
+}